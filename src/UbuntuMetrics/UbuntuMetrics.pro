@@ -21,6 +21,7 @@ HEADERS += \
     $$PWD/events.h \
     $$PWD/events_p.h \
     $$PWD/gputimer_p.h \
+    $$PWD/histogram_p.h \
     $$PWD/logger.h \
     $$PWD/logger_p.h \
     $$PWD/overlay_p.h \
@@ -32,6 +33,7 @@ SOURCES += \
     $$PWD/bitmaptext.cpp \
     $$PWD/events.cpp \
     $$PWD/gputimer.cpp \
+    $$PWD/histogram.cpp \
     $$PWD/logger.cpp \
     $$PWD/overlay.cpp \
     $$PWD/ubuntumetricsglobal.cpp
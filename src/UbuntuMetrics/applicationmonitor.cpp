@@ -17,26 +17,44 @@
 
 #include "applicationmonitor_p.h"
 
+#include <atomic>
+#include <new>
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
 #include <QtCore/QTimer>
 #include <QtGui/QGuiApplication>
+#include <QtGui/QScreen>
 #include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qsgrenderloop_p.h>
 
 // FIXME(loicm) When a monitored window is destroyed and if there's a window
 //     that's not monitored because the max count was reached, enable monitoring
 //     on it if possible.
 
-const int logQueueSize = 16;
 const int logQueueAlignment = 64;
 
-LoggingThread::LoggingThread()
-    : m_loggerCount(0)
+LoggingThread::LoggingThread(int queueSize, UMApplicationMonitor::OverflowPolicy policy)
+    : m_queueMask(queueSize - 1)
+    , m_loggerCount(0)
     , m_refCount(1)
-    , m_queueIndex(0)
-    , m_queueSize(0)
-    , m_flags(0)
+    , m_droppedEventCount(0)
+    , m_flags(policy == UMApplicationMonitor::BlockOnOverflow ? BlockOnOverflow : 0)
+    , m_dequeueIndex(0)
+    , m_waiting(0)
+    , m_enqueueIndex(0)
 {
-    m_queue = static_cast<UMEvent*>(
-        alignedAlloc(logQueueAlignment, logQueueSize * sizeof(UMEvent)));
+    DASSERT(IS_POWER_OF_TWO(queueSize));
+    DASSERT(queueSize >= UMApplicationMonitorPrivate::minLoggingQueueSize);
+
+    // The slot size times the min queue size is a multiple of the alignment.
+    m_queue = static_cast<Slot*>(alignedAlloc(logQueueAlignment, queueSize * sizeof(Slot)));
+    for (int i = 0; i < queueSize; ++i) {
+        new (&m_queue[i].sequence) QAtomicInteger<quint32>(i);
+    }
 
 #if !defined(QT_NO_DEBUG)
     setObjectName(QStringLiteral("UbuntuMetrics logging"));  // Thread name.
@@ -46,78 +64,152 @@ LoggingThread::LoggingThread()
 
 LoggingThread::~LoggingThread()
 {
-    m_mutex.lock();
-    m_flags |= JoinRequested;
-    if (m_flags & Waiting) {
-        m_condition.wakeOne();
-    }
-    m_mutex.unlock();
+    m_flags.fetchAndOrOrdered(JoinRequested);
+    m_waiting.store(0);
+    wakeUp();
     wait();
 
     free(m_queue);
 }
 
-#define BREAK_ON_JOIN_REQUEST()                \
-    if (Q_UNLIKELY(m_flags & JoinRequested)) { \
-        m_mutex.unlock();                      \
-        break;                                 \
+#if defined(Q_OS_LINUX)
+
+static inline int* futexAddress(QAtomicInteger<int>* atomic)
+{
+    Q_STATIC_ASSERT(sizeof(QAtomicInteger<int>) == sizeof(int));
+    return reinterpret_cast<int*>(atomic);
+}
+
+// Sleeps until the futex word doesn't contain 1 anymore. Returns immediately
+// if it's already the case.
+void LoggingThread::waitForEvents()
+{
+    syscall(SYS_futex, futexAddress(&m_waiting), FUTEX_WAIT_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void LoggingThread::wakeUp()
+{
+    syscall(SYS_futex, futexAddress(&m_waiting), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+#else
+
+void LoggingThread::waitForEvents()
+{
+    m_mutex.lock();
+    while (m_waiting.load() == 1) {
+        m_condition.wait(&m_mutex);
     }
+    m_mutex.unlock();
+}
+
+void LoggingThread::wakeUp()
+{
+    m_mutex.lock();
+    m_condition.wakeOne();
+    m_mutex.unlock();
+}
+
+#endif  // defined(Q_OS_LINUX)
 
 // Logging thread entry point.
 void LoggingThread::run()
 {
     DLOG("Entering logging thread.");
+    UMEvent event;
     while (true) {
-        // Wait for new events in the log queue.
-        m_mutex.lock();
-        DASSERT(m_queueSize >= 0);
-        if (m_queueSize == 0) {
-            BREAK_ON_JOIN_REQUEST();
-            m_flags |= Waiting;
-            m_condition.wait(&m_mutex);
-            if (m_queueSize == 0) {
-                BREAK_ON_JOIN_REQUEST();
+        // Unqueue oldest events from the log queue.
+        if (pop(&event)) {
+            m_loggersMutex.lock();
+            const int loggerCount = m_loggerCount;
+            UMLogger* loggers[UMApplicationMonitorPrivate::maxLoggers];
+            memcpy(loggers, m_loggers, loggerCount * sizeof(UMLogger*));
+            m_loggersMutex.unlock();
+            for (int i = 0; i < loggerCount; ++i) {
+                loggers[i]->log(event);
             }
-            m_flags &= ~Waiting;
+            continue;
         }
 
-        // Unqueue oldest events from the log queue.
-        DASSERT(m_queueSize > 0);
-        UMEvent event;
-        memcpy(&event, &m_queue[m_queueIndex], sizeof(UMEvent));
-        m_queueIndex = (m_queueIndex + 1) % logQueueSize;
-        m_queueSize--;
-
-        // Log.
-        const int loggerCount = m_loggerCount;
-        UMLogger* loggers[UMApplicationMonitorPrivate::maxLoggers];
-        memcpy(loggers, m_loggers, loggerCount * sizeof(UMLogger*));
-        m_mutex.unlock();
-        for (int i = 0; i < loggerCount; ++i) {
-            loggers[i]->log(event);
+        if (Q_UNLIKELY(m_flags.load() & JoinRequested)) {
+            break;
         }
+
+        // The queue is empty, flag the logging thread as waiting (full
+        // barrier) and check again before sleeping so that a wake up can't be
+        // missed.
+        m_waiting.fetchAndStoreOrdered(1);
+        const quint32 sequence = m_queue[m_dequeueIndex & m_queueMask].sequence.loadAcquire();
+        if (sequence != m_dequeueIndex + 1 && !(m_flags.load() & JoinRequested)) {
+            waitForEvents();
+        }
+        m_waiting.store(0);
     }
     DLOG("Leaving logging thread.");
 }
 
-void LoggingThread::push(const UMEvent* event)
+// Consumer side of the queue, must only be called by the logging thread.
+bool LoggingThread::pop(UMEvent* event)
 {
-    // Ensure the log queue is not full.
-    m_mutex.lock();
-    DASSERT(m_queueSize <= logQueueSize);
-    while (m_queueSize == logQueueSize) {
-        m_mutex.unlock();
-        QThread::yieldCurrentThread();
-        m_mutex.lock();
+    Slot* slot = &m_queue[m_dequeueIndex & m_queueMask];
+    if (slot->sequence.loadAcquire() != m_dequeueIndex + 1) {
+        return false;
+    }
+    memcpy(event, &slot->event, sizeof(UMEvent));
+    slot->sequence.storeRelease(m_dequeueIndex + m_queueMask + 1);
+    m_dequeueIndex++;
+    return true;
+}
+
+// Producer side of the queue, can be called concurrently from any thread. Based
+// on Dmitry Vyukov's bounded queue, a slot is owned by a producer once it won
+// the race on the enqueue index for the slot's sequence number.
+bool LoggingThread::push(const UMEvent* event)
+{
+    Slot* slot;
+    quint32 index = m_enqueueIndex.load();
+    while (true) {
+        slot = &m_queue[index & m_queueMask];
+        const qint32 difference =
+            static_cast<qint32>(slot->sequence.loadAcquire() - index);
+        if (difference == 0) {
+            if (m_enqueueIndex.testAndSetRelaxed(index, index + 1, index)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The queue is full.
+            if (!(m_flags.load() & BlockOnOverflow)) {
+                m_droppedEventCount.ref();
+                return false;
+            }
+            QThread::yieldCurrentThread();
+            index = m_enqueueIndex.load();
+        } else {
+            // Another producer took the slot, try again.
+            index = m_enqueueIndex.load();
+        }
     }
 
     // Push event to the log queue.
-    DASSERT(m_queueSize < logQueueSize);
-    memcpy(&m_queue[(m_queueIndex + m_queueSize++) % logQueueSize], event, sizeof(UMEvent));
-    if (m_flags & Waiting) {
-        m_condition.wakeOne();
+    memcpy(&slot->event, event, sizeof(UMEvent));
+    slot->sequence.storeRelease(index + 1);
+
+    // Wake up the logging thread if needed. The fence ensures the waiting flag
+    // is read after the slot got published.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiting.load() == 1 && m_waiting.testAndSetRelaxed(1, 0)) {
+        wakeUp();
+    }
+    return true;
+}
+
+void LoggingThread::setOverflowPolicy(UMApplicationMonitor::OverflowPolicy policy)
+{
+    if (policy == UMApplicationMonitor::BlockOnOverflow) {
+        m_flags.fetchAndOrRelaxed(BlockOnOverflow);
+    } else {
+        m_flags.fetchAndAndRelaxed(~BlockOnOverflow);
     }
-    m_mutex.unlock();
 }
 
 void LoggingThread::setLoggers(UMLogger** loggers, int count)
@@ -125,7 +217,7 @@ void LoggingThread::setLoggers(UMLogger** loggers, int count)
     DASSERT(count >= 0);
     DASSERT(count <= UMApplicationMonitorPrivate::maxLoggers);
 
-    QMutexLocker locker(&m_mutex);
+    QMutexLocker locker(&m_loggersMutex);
     memcpy(m_loggers, loggers, count * sizeof(UMLogger*));
     m_loggerCount = count;
 }
@@ -165,8 +257,11 @@ UMApplicationMonitorPrivate::UMApplicationMonitorPrivate(UMApplicationMonitor* a
     , m_loggingThread(nullptr)
     , m_monitorCount(0)
     , m_loggerCount(0)
-    , m_updateInterval{1000, -1, -1}
+    , m_loggingQueueSize(defaultLoggingQueueSize)
+    , m_updateInterval{1000, -1, -1, -1, -1}
     , m_flags(UMApplicationMonitor::AllEvents)
+    , m_droppedEventCount(0)
+    , m_overflowPolicy(UMApplicationMonitor::DropOnOverflow)
 {
     Q_Q(UMApplicationMonitor);
 
@@ -181,6 +276,7 @@ UMApplicationMonitorPrivate::UMApplicationMonitorPrivate(UMApplicationMonitor* a
     QObject::connect(application, SIGNAL(lastWindowClosed()), q, SLOT(closeDown()));
     QObject::connect(application, SIGNAL(aboutToQuit()), q, SLOT(closeDown()));
     QObject::connect(&m_processTimer, SIGNAL(timeout()), q, SLOT(processTimeout()));
+    QObject::connect(&m_frameSummaryTimer, SIGNAL(timeout()), q, SLOT(frameSummaryTimeout()));
 
     m_processTimer.setInterval(m_updateInterval[UMEvent::Process]);
 }
@@ -282,7 +378,7 @@ void UMApplicationMonitorPrivate::start()
     DASSERT(!(m_flags & Started));
     DASSERT(!m_loggingThread);
 
-    m_loggingThread = new LoggingThread;
+    m_loggingThread = new LoggingThread(m_loggingQueueSize, m_overflowPolicy);
     m_loggingThread->setLoggers(m_loggers, m_loggerCount);
 
     QWindowList windows = QGuiApplication::allWindows();
@@ -307,6 +403,9 @@ void UMApplicationMonitorPrivate::start()
     if (m_updateInterval[UMEvent::Process] >= 0) {
         m_processTimer.start();
     }
+    if (m_updateInterval[UMEvent::FrameSummary] >= 0) {
+        m_frameSummaryTimer.start();
+    }
 }
 
 bool UMApplicationMonitorPrivate::removeMonitor(WindowMonitor* monitor)
@@ -380,6 +479,9 @@ void UMApplicationMonitorPrivate::stop()
     if (m_updateInterval[UMEvent::Process] >= 0) {
         m_processTimer.stop();
     }
+    if (m_updateInterval[UMEvent::FrameSummary] >= 0) {
+        m_frameSummaryTimer.stop();
+    }
 
     QGuiApplication::instance()->removeEventFilter(q_func());
 
@@ -390,6 +492,7 @@ void UMApplicationMonitorPrivate::stop()
     m_monitorsMutex.unlock();
 
     DASSERT(m_loggingThread);
+    m_droppedEventCount = m_loggingThread->droppedEventCount();
     m_loggingThread->deref();
     m_loggingThread = nullptr;
 
@@ -550,6 +653,58 @@ void UMApplicationMonitor::clearLoggers(bool free)
     }
 }
 
+void UMApplicationMonitor::setLoggingQueueSize(int size)
+{
+    Q_D(UMApplicationMonitor);
+
+    size = qBound(UMApplicationMonitorPrivate::minLoggingQueueSize, size,
+                  UMApplicationMonitorPrivate::maxLoggingQueueSize);
+    int powerOfTwoSize = UMApplicationMonitorPrivate::minLoggingQueueSize;
+    while (powerOfTwoSize < size) {
+        powerOfTwoSize <<= 1;
+    }
+    if (powerOfTwoSize != d->m_loggingQueueSize) {
+        d->m_loggingQueueSize = powerOfTwoSize;
+        Q_EMIT loggingQueueSizeChanged();
+    }
+}
+
+int UMApplicationMonitor::loggingQueueSize()
+{
+    return d_func()->m_loggingQueueSize;
+}
+
+void UMApplicationMonitor::setLoggingOverflowPolicy(UMApplicationMonitor::OverflowPolicy policy)
+{
+    Q_D(UMApplicationMonitor);
+
+    if (policy != d->m_overflowPolicy) {
+        d->m_overflowPolicy = policy;
+        if (d->m_flags & UMApplicationMonitorPrivate::Started) {
+            DASSERT(d->m_loggingThread);
+            d->m_loggingThread->setOverflowPolicy(policy);
+        }
+        Q_EMIT loggingOverflowPolicyChanged();
+    }
+}
+
+UMApplicationMonitor::OverflowPolicy UMApplicationMonitor::loggingOverflowPolicy()
+{
+    return d_func()->m_overflowPolicy;
+}
+
+quint32 UMApplicationMonitor::droppedEventCount()
+{
+    Q_D(UMApplicationMonitor);
+
+    if (d->m_flags & UMApplicationMonitorPrivate::Started) {
+        DASSERT(d->m_loggingThread);
+        return d->m_loggingThread->droppedEventCount();
+    } else {
+        return d->m_droppedEventCount;
+    }
+}
+
 quint32 UMApplicationMonitor::registerGenericEvent()
 {
     static quint32 id = 0;  // 0 is reserved for UMApplicationMonitor events.
@@ -596,22 +751,29 @@ void UMApplicationMonitor::setUpdateInterval(UMEvent::Type type, int interval)
 {
     Q_D(UMApplicationMonitor);
 
+    // Other types (like UMEvent::Frame) are ignored for now.
+    QTimer* timer;
     if (type == UMEvent::Process) {
-        // Other types (like UMEvent::Frame) are ignored for now.
-        if (interval != d->m_updateInterval[UMEvent::Process]) {
-            if (interval >= 0) {
-                d->m_processTimer.setInterval(interval);
-                if ((d->m_flags & UMApplicationMonitorPrivate::Started)
-                    && (d->m_updateInterval[UMEvent::Process] < 0)) {
-                    d->m_processTimer.start();
-                }
-            } else if ((d->m_flags & UMApplicationMonitorPrivate::Started)
-                       && (d->m_updateInterval[UMEvent::Process] >= 0)) {
-                d->m_processTimer.stop();
+        timer = &d->m_processTimer;
+    } else if (type == UMEvent::FrameSummary) {
+        timer = &d->m_frameSummaryTimer;
+    } else {
+        return;
+    }
+
+    if (interval != d->m_updateInterval[type]) {
+        if (interval >= 0) {
+            timer->setInterval(interval);
+            if ((d->m_flags & UMApplicationMonitorPrivate::Started)
+                && (d->m_updateInterval[type] < 0)) {
+                timer->start();
             }
-            d->m_updateInterval[UMEvent::Process] = interval;
-            Q_EMIT updateIntervalChanged(UMEvent::Process);
+        } else if ((d->m_flags & UMApplicationMonitorPrivate::Started)
+                   && (d->m_updateInterval[type] >= 0)) {
+            timer->stop();
         }
+        d->m_updateInterval[type] = interval;
+        Q_EMIT updateIntervalChanged(type);
     }
 }
 
@@ -646,6 +808,7 @@ void UMApplicationMonitorPrivate::processTimeout()
 
     if (processLogging || overlay) {
         m_eventUtils.updateProcessEvent(&m_processEvent);
+        m_processEvent.process.droppedEvents = m_loggingThread->droppedEventCount();
         if (processLogging) {
             m_loggingThread->push(&m_processEvent);
         }
@@ -667,6 +830,48 @@ void UMApplicationMonitorPrivate::processTimeout()
     }
 }
 
+bool UMApplicationMonitor::frameSummary(quint32 windowId, UMEvent* event, bool reset)
+{
+    DASSERT(event);
+    Q_D(UMApplicationMonitor);
+
+    bool found = false;
+    d->m_monitorsMutex.lock();
+    for (int i = 0; i < d->m_monitorCount; ++i) {
+        DASSERT(d->m_monitors[i]);
+        if (d->m_monitors[i]->id() == windowId) {
+            d->m_monitors[i]->frameSummary(event, reset);
+            found = true;
+            break;
+        }
+    }
+    d->m_monitorsMutex.unlock();
+    return found;
+}
+
+void UMApplicationMonitor::frameSummaryTimeout()
+{
+    d_func()->frameSummaryTimeout();
+}
+
+void UMApplicationMonitorPrivate::frameSummaryTimeout()
+{
+    DASSERT(m_flags & Started);
+    DASSERT(m_loggingThread);
+
+    const bool logging = (m_flags & Logging) && (m_flags & UMApplicationMonitor::FrameSummaryEvent);
+    UMEvent event;
+    m_monitorsMutex.lock();
+    for (int i = 0; i < m_monitorCount; ++i) {
+        DASSERT(m_monitors[i]);
+        m_monitors[i]->frameSummary(&event, true);
+        if (logging) {
+            m_loggingThread->push(&event);
+        }
+    }
+    m_monitorsMutex.unlock();
+}
+
 bool UMApplicationMonitor::eventFilter(QObject* object, QEvent* event)
 {
     if (event->type() == QEvent::Show) {
@@ -692,7 +897,9 @@ static const char* const defaultOverlayText =
     "  SG sync. : %9syncTime ms\n"
     " SG render : %9renderTime ms\n"
     "       GPU : %9gpuTime ms\n"
-    "     Total : %9totalTime ms\r"
+    "     Total : %9totalTime ms\n"
+    " Delta p99 : %9p99DeltaTime ms\n"
+    "    Missed : %9missedVsyncs   \r"
     "  VSZ mem. : %9vszMemory kB\n"
     "  RSS mem. : %9rssMemory kB\n"
     "   Threads : %9threadCount   \n"
@@ -705,6 +912,8 @@ WindowMonitor::WindowMonitor(
     , m_loggingThread(loggingThread)
     , m_window(window)
     , m_overlay(defaultOverlayText, id)
+    , m_missedVsyncCount(0)
+    , m_animationState(AnimationIdle)
     , m_id(id)
     , m_flags(flags)
     , m_frameSize(window->width(), window->height())
@@ -733,10 +942,29 @@ WindowMonitor::WindowMonitor(
     QObject::connect(window, SIGNAL(sceneGraphAboutToStop()), this,
                      SLOT(windowSceneGraphAboutToStop()), Qt::DirectConnection);
 
+    // QtQuick renders on demand, frames are rendered back to back only while
+    // the animation driver is running, the render loop is idle otherwise.
+    QAnimationDriver* animationDriver = QSGRenderLoop::instance()->animationDriver();
+    if (animationDriver) {
+        QObject::connect(animationDriver, SIGNAL(started()), this,
+                         SLOT(animationDriverStarted()), Qt::DirectConnection);
+        QObject::connect(animationDriver, SIGNAL(stopped()), this,
+                         SLOT(animationDriverStopped()), Qt::DirectConnection);
+        if (animationDriver->isRunning()) {
+            m_animationState.store(AnimationStarted);
+        }
+    }
+
     memset(&m_frameEvent, 0, sizeof(m_frameEvent));
     m_frameEvent.type = UMEvent::Frame;
     m_frameEvent.frame.window = id;
 
+    // A frame is considered to have missed a vsync when its delta time is
+    // higher than one and a half the refresh interval.
+    QScreen* screen = window->screen();
+    const qreal refreshRate = screen && screen->refreshRate() > 1.0 ? screen->refreshRate() : 60.0;
+    m_missedVsyncThreshold = static_cast<quint64>(1.5 * 1000000000.0 / refreshRate);
+
     if ((flags & UMApplicationMonitorPrivate::Logging)
         && (flags & UMApplicationMonitor::WindowEvent)) {
         UMEvent event;
@@ -857,7 +1085,14 @@ void WindowMonitor::windowAfterRendering()
         m_frameEvent.frame.gpuTime = (m_flags & GpuTimerAvailable) ? m_gpuTimer.stop() : 0;
         m_frameEvent.frame.number++;
         if (m_flags & UMApplicationMonitorPrivate::Overlay) {
+            // Frame summaries are cheap but not free to compute, refresh every
+            // 16 frames.
             m_mutex.lock();
+            if ((m_frameEvent.frame.number & 15) == 1) {
+                UMEvent event;
+                frameSummary(&event, false);
+                m_overlay.setFrameSummaryEvent(event);
+            }
             m_overlay.render(m_frameEvent, m_frameSize);
             m_mutex.unlock();
         }
@@ -870,9 +1105,16 @@ void WindowMonitor::windowFrameSwapped()
     if (m_flags & GpuResourcesInitialized) {
         m_frameEvent.frame.deltaTime = m_deltaTimer.isValid() ? m_deltaTimer.nsecsElapsed() : 0;
         m_deltaTimer.start();
+        m_frameEvent.frame.swapTime = m_sceneGraphTimer.nsecsElapsed();
+        // The delta of the first frame swapped once the animation driver
+        // started still spans the idle period.
+        bool backToBack = false;
+        if (!m_animationState.testAndSetRelaxed(AnimationStarted, AnimationRunning)) {
+            backToBack = m_animationState.load() == AnimationRunning;
+        }
+        recordFrame(backToBack);
         if ((m_flags & UMApplicationMonitorPrivate::Logging) &&
             (m_flags & UMApplicationMonitor::FrameEvent)) {
-            m_frameEvent.frame.swapTime = m_sceneGraphTimer.nsecsElapsed();
             m_frameEvent.timeStamp = UMEventUtils::timeStamp();
             m_loggingThread->push(&m_frameEvent);
         }
@@ -884,6 +1126,18 @@ void WindowMonitor::windowFrameSwapped()
     }
 }
 
+// GUI thread.
+void WindowMonitor::animationDriverStarted()
+{
+    m_animationState.store(AnimationStarted);
+}
+
+// GUI thread.
+void WindowMonitor::animationDriverStopped()
+{
+    m_animationState.store(AnimationIdle);
+}
+
 void WindowMonitor::windowSceneGraphAboutToStop()
 {
 #if !defined(QT_NO_DEBUG)
@@ -910,3 +1164,40 @@ void WindowMonitor::setProcessEvent(const UMEvent& event)
         m_window->update();
     }
 }
+
+// Render thread only. Delta times spanning an idle period of the render loop
+// are logged but neither recorded in the histogram nor counted as missed vsyncs.
+void WindowMonitor::recordFrame(bool backToBack)
+{
+    if (backToBack && m_frameEvent.frame.deltaTime > 0) {
+        m_histograms[UMFrameSummaryEvent::DeltaTime].record(m_frameEvent.frame.deltaTime);
+        if (m_frameEvent.frame.deltaTime > m_missedVsyncThreshold) {
+            m_missedVsyncCount.fetchAndAddRelaxed(1);
+        }
+    }
+    m_histograms[UMFrameSummaryEvent::SyncTime].record(m_frameEvent.frame.syncTime);
+    m_histograms[UMFrameSummaryEvent::RenderTime].record(m_frameEvent.frame.renderTime);
+    if (m_flags & GpuTimerAvailable) {
+        m_histograms[UMFrameSummaryEvent::GpuTime].record(m_frameEvent.frame.gpuTime);
+    }
+    m_histograms[UMFrameSummaryEvent::SwapTime].record(m_frameEvent.frame.swapTime);
+}
+
+// Can be called from any thread.
+void WindowMonitor::frameSummary(UMEvent* event, bool reset)
+{
+    DASSERT(event);
+
+    memset(event, 0, sizeof(UMEvent));
+    event->type = UMEvent::FrameSummary;
+    event->timeStamp = UMEventUtils::timeStamp();
+    event->frameSummary.window = m_id;
+    for (int i = 0; i < UMFrameSummaryEvent::MetricCount; ++i) {
+        const quint32 count = m_histograms[i].statistics(event->frameSummary.times[i], reset);
+        if (i == UMFrameSummaryEvent::SyncTime) {
+            event->frameSummary.frameCount = count;
+        }
+    }
+    event->frameSummary.missedVsyncCount =
+        reset ? m_missedVsyncCount.fetchAndStoreRelaxed(0) : m_missedVsyncCount.load();
+}
@@ -43,11 +43,24 @@ public:
         FrameEvent   = (1 << 2),
         // Allow generic events logging.
         GenericEvent = (1 << 3),
+        // Allow frame summary events logging.
+        FrameSummaryEvent = (1 << 4),
         // Allow all events logging.
-        AllEvents    = (ProcessEvent | WindowEvent | FrameEvent | GenericEvent)
+        AllEvents    = (ProcessEvent | WindowEvent | FrameEvent | GenericEvent | FrameSummaryEvent)
     };
     Q_DECLARE_FLAGS(LoggingFilters, LoggingFilter)
 
+    enum OverflowPolicy {
+        // Discard events pushed while the logging queue is full and increment
+        // the dropped events counter. Threads pushing events are never
+        // blocked.
+        DropOnOverflow  = 0,
+        // Wait for the logging thread to make room in the queue when it is
+        // full. Allows to log all the events at the cost of stalling the
+        // threads pushing events (like the QtQuick render threads).
+        BlockOnOverflow = 1
+    };
+
     enum Event {
         // Application defined event indicating that the initialisation is done
         // and the UI ready. It can be used by tools to measure the time needed
@@ -77,6 +90,22 @@ public:
     bool removeLogger(UMLogger* logger, bool free = true);
     void clearLoggers(bool free = true);
 
+    // Set the capacity of the lock-free queue storing the events before being
+    // logged by the logging thread. The size is rounded up to the next
+    // power-of-two and bounded to [8, 65536], default value is 64. A new size
+    // is taken into account the next time monitoring is started.
+    void setLoggingQueueSize(int size);
+    int loggingQueueSize();
+
+    // Set the behavior when the logging queue is full, DropOnOverflow by
+    // default.
+    void setLoggingOverflowPolicy(OverflowPolicy policy);
+    OverflowPolicy loggingOverflowPolicy();
+
+    // Get the number of events dropped because the logging queue was full
+    // since monitoring started. That number is also stored in process events.
+    quint32 droppedEventCount();
+
     // Generic event system allowing to log application specific
     // events. registerGenericEvent() returns a unique integer id to be used as
     // first argument to logGenericEvent(). logGenericEvent() logs a generic
@@ -93,22 +122,33 @@ public:
     bool logEvent(Event event);
 
     // Set the time in milliseconds between two updates of events of a given
-    // type. -1 to disable updates. Only UMEvent::Process is accepted so far as
-    // event type, default value is 1000. Note that when the overlay is enabled,
-    // a process update triggers a frame update.
+    // type. -1 to disable updates. Only UMEvent::Process (default value is
+    // 1000) and UMEvent::FrameSummary (default value is -1) are accepted so far
+    // as event types. Note that when the overlay is enabled, a process update
+    // triggers a frame update. A frame summary update logs a frame summary
+    // event per monitored window and resets its frame time statistics.
     void setUpdateInterval(UMEvent::Type type, int interval);
     int updateInterval(UMEvent::Type type);
 
+    // Fill the given event with the frame time statistics of the monitored
+    // window with the given id (as stored in window events) since monitoring
+    // started or since the last reset. The statistics are reset if reset is
+    // true. Returns false if there's no monitored window with that id.
+    bool frameSummary(quint32 windowId, UMEvent* event, bool reset = false);
+
 Q_SIGNALS:
     void overlayChanged();
     void loggingChanged();
     void loggingFilterChanged();
     void loggersChanged();
+    void loggingQueueSizeChanged();
+    void loggingOverflowPolicyChanged();
     void updateIntervalChanged(UMEvent::Type type);
 
 private Q_SLOTS:
     void closeDown();
     void processTimeout();
+    void frameSummaryTimeout();
 
 private:
     static UMApplicationMonitor* self;
@@ -30,6 +30,7 @@
 
 #include <UbuntuMetrics/private/overlay_p.h>
 #include <UbuntuMetrics/private/gputimer_p.h>
+#include <UbuntuMetrics/private/histogram_p.h>
 #include <UbuntuMetrics/private/ubuntumetricsglobal_p.h>
 
 class LoggingThread;
@@ -41,6 +42,9 @@ class UBUNTU_METRICS_PRIVATE_EXPORT UMApplicationMonitorPrivate
 public:
     static const int maxMonitors = 16;
     static const int maxLoggers = 8;
+    static const int defaultLoggingQueueSize = 64;
+    static const int minLoggingQueueSize = 8;
+    static const int maxLoggingQueueSize = 65536;
 
     static inline UMApplicationMonitorPrivate* get(UMApplicationMonitor* applicationMonitor) {
         return applicationMonitor->d_func();
@@ -69,6 +73,7 @@ public:
     bool hasMonitor(WindowMonitor* monitor);
     void setMonitoringFlags(quint32 flags);
     void processTimeout();
+    void frameSummaryTimeout();
 
     UMApplicationMonitor* const q_ptr;
     Q_DECLARE_PUBLIC(UMApplicationMonitor)
@@ -81,42 +86,72 @@ public:
 #endif
     UMEventUtils m_eventUtils;
     QTimer m_processTimer;
+    QTimer m_frameSummaryTimer;
     QMutex m_monitorsMutex;
     int m_monitorCount;
     int m_loggerCount;
+    int m_loggingQueueSize;
     int m_updateInterval[UMEvent::TypeCount];
     quint32 m_flags;
+    quint32 m_droppedEventCount;
+    UMApplicationMonitor::OverflowPolicy m_overflowPolicy;
     alignas(64) UMEvent m_processEvent;
 };
 
+// Thread logging the events with the installed loggers. Events are pushed by
+// the QtQuick render threads and the GUI thread in a bounded lock-free
+// multi-producer single-consumer queue, so that pushing never requires a lock
+// and, depending on the overflow policy, never blocks.
 class UBUNTU_METRICS_PRIVATE_EXPORT LoggingThread : public QThread
 {
 public:
-    LoggingThread();
+    LoggingThread(int queueSize, UMApplicationMonitor::OverflowPolicy policy);
 
     void run() override;
-    void push(const UMEvent* event);
+    bool push(const UMEvent* event);
     void setLoggers(UMLogger** loggers, int count);
+    void setOverflowPolicy(UMApplicationMonitor::OverflowPolicy policy);
+    quint32 droppedEventCount() { return m_droppedEventCount.load(); }
     LoggingThread* ref();
     void deref();
 
 private:
     enum {
-        Waiting       = (1 << 0),
-        JoinRequested = (1 << 1)
+        JoinRequested   = (1 << 0),
+        BlockOnOverflow = (1 << 1)
+    };
+
+    // Queue slot. The sequence number is used by producers and the consumer
+    // to know whether the slot is free or filled.
+    struct Slot {
+        QAtomicInteger<quint32> sequence;
+        UMEvent event;
     };
 
     ~LoggingThread();
 
-    UMEvent* m_queue;
+    bool pop(UMEvent* event);
+    void waitForEvents();
+    void wakeUp();
+
+    Slot* m_queue;
+    quint32 m_queueMask;
     UMLogger* m_loggers[UMApplicationMonitorPrivate::maxLoggers];
     int m_loggerCount;
+    QMutex m_loggersMutex;
+#if !defined(Q_OS_LINUX)
     QMutex m_mutex;
     QWaitCondition m_condition;
+#endif
     QAtomicInteger<quint32> m_refCount;
-    qint8 m_queueIndex;
-    qint8 m_queueSize;
-    quint8 m_flags;
+    QAtomicInteger<quint32> m_droppedEventCount;
+    QAtomicInteger<quint32> m_flags;
+    // Accessed by the consumer only.
+    quint32 m_dequeueIndex;
+    // Futex word set to 1 by the consumer when waiting for events.
+    alignas(64) QAtomicInteger<int> m_waiting;
+    // Shared by the producers, on its own cache line.
+    alignas(64) QAtomicInteger<quint32> m_enqueueIndex;
 };
 
 class UBUNTU_METRICS_PRIVATE_EXPORT WindowMonitorDeleter : public QRunnable
@@ -169,7 +204,9 @@ public:
     ~WindowMonitor();
 
     QQuickWindow* window() const { return m_window; }
+    quint32 id() const { return m_id; }
     void setProcessEvent(const UMEvent& event);
+    void frameSummary(UMEvent* event, bool reset);
 
 private Q_SLOTS:
     void windowSceneGraphInitialized();
@@ -180,6 +217,8 @@ private Q_SLOTS:
     void windowAfterRendering();
     void windowFrameSwapped();
     void windowSceneGraphAboutToStop();
+    void animationDriverStarted();
+    void animationDriverStopped();
 
 private:
     enum {
@@ -189,6 +228,7 @@ private:
         SizeChanged             = (1 << 18)
         // Higher bit allowed is (1 << 31).
     };
+    enum { AnimationIdle = 0, AnimationStarted = 1, AnimationRunning = 2 };
 
     bool gpuResourcesInitialized() const { return m_flags & GpuResourcesInitialized; }
     void setFlags(quint32 flags) {
@@ -196,6 +236,7 @@ private:
     }
     void initializeGpuResources();
     void finalizeGpuResources();
+    void recordFrame(bool backToBack);
 
     UMApplicationMonitor* m_applicationMonitor;
     LoggingThread* m_loggingThread;
@@ -205,6 +246,12 @@ private:
     QMutex m_mutex;
     QElapsedTimer m_sceneGraphTimer;
     QElapsedTimer m_deltaTimer;
+    // Written by the render thread, read by the GUI thread.
+    FrameHistogram m_histograms[UMFrameSummaryEvent::MetricCount];
+    QAtomicInteger<quint32> m_missedVsyncCount;
+    quint64 m_missedVsyncThreshold;
+    // Written by the GUI thread, read by the render thread.
+    QAtomicInt m_animationState;
     quint32 m_id;
     quint32 m_flags;
     QSize m_frameSize;
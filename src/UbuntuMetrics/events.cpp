@@ -20,13 +20,16 @@
 #include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <dirent.h>
+#include <sys/resource.h>
 #include <cstdio>
 
 #include <QtCore/QElapsedTimer>
 
 #include "ubuntumetricsglobal_p.h"
 
-const int bufferSize = 128;
+// Big enough to store /proc/self/smaps_rollup.
+const int bufferSize = 4096;
 const int bufferAlignment = 64;
 
 UMEventUtils::UMEventUtils()
@@ -35,6 +38,11 @@ UMEventUtils::UMEventUtils()
 }
 
 EventUtilsPrivate::EventUtilsPrivate()
+    : m_minorFaults(0)
+    , m_majorFaults(0)
+    , m_voluntaryContextSwitches(0)
+    , m_involuntaryContextSwitches(0)
+    , m_threadCount(0)
 {
 #if !defined(QT_NO_DEBUG)
     ASSERT(m_buffer = static_cast<char*>(alignedAlloc(bufferAlignment, bufferSize)));
@@ -45,6 +53,21 @@ EventUtilsPrivate::EventUtilsPrivate()
     m_cpuTicks = times(&m_cpuTimes);
     m_cpuOnlineCores = sysconf(_SC_NPROCESSORS_ONLN);
     m_pageSize = sysconf(_SC_PAGESIZE);
+    m_clockTicksPerSecond = sysconf(_SC_CLK_TCK);
+    m_pid = getpid();
+
+    // The files are kept open and read with pread() at each update.
+    if ((m_statFd = open("/proc/self/stat", O_RDONLY | O_CLOEXEC)) == -1) {
+        DWARN("EventUtils: can't open '/proc/self/stat'");
+    }
+    // Not available before Linux 4.14.
+    m_smapsFd = open("/proc/self/smaps_rollup", O_RDONLY | O_CLOEXEC);
+
+    // Set the initial resource usage and thread CPU times so that the first
+    // update only reports the deltas.
+    UMEvent event;
+    updateResourceUsageMetrics(&event);
+    updateThreads();
 }
 
 UMEventUtils::~UMEventUtils()
@@ -54,6 +77,15 @@ UMEventUtils::~UMEventUtils()
 
 EventUtilsPrivate::~EventUtilsPrivate()
 {
+    for (int i = 0; i < m_threadCount; ++i) {
+        close(m_threads[i].fd);
+    }
+    if (m_smapsFd != -1) {
+        close(m_smapsFd);
+    }
+    if (m_statFd != -1) {
+        close(m_statFd);
+    }
     free(m_buffer);
 }
 
@@ -66,6 +98,57 @@ void UMEventUtils::updateProcessEvent(UMEvent* event)
     event->timeStamp = UMEventUtils::timeStamp();
     d->updateCpuUsage(event);
     d->updateProcStatMetrics(event);
+    d->updateResourceUsageMetrics(event);
+    d->updateSmapsMetrics(event);
+}
+
+// Reads a /proc file from the beginning to the buffer and null-terminates
+// it. Returns the number of bytes read, -1 on error.
+int EventUtilsPrivate::readProcFile(int fd)
+{
+    DASSERT(fd != -1);
+
+    const int readSize = pread(fd, m_buffer, bufferSize - 1, 0);
+    if (readSize <= 0) {
+        return -1;
+    }
+    m_buffer[readSize] = '\0';
+    return readSize;
+}
+
+// Returns a pointer to the first entry of a /proc stat file following the
+// command name (entry 3 as listed by 'man proc'), null if not found. The
+// command name is skipped from the last ')' since it can contain spaces.
+static const char* statEntries(const char* buffer)
+{
+    const char* entries = strrchr(buffer, ')');
+    return entries && entries[1] == ' ' ? entries + 2 : nullptr;
+}
+
+// Skips count space-separated entries. Returns null if the end of the string
+// is reached.
+static const char* skipEntries(const char* entries, int count)
+{
+    while (count > 0) {
+        if (*entries == '\0') {
+            return nullptr;
+        } else if (*entries++ == ' ') {
+            count--;
+        }
+    }
+    return *entries != '\0' ? entries : nullptr;
+}
+
+// Parses an unsigned integer and moves the pointer past it.
+static quint64 parseUnsigned(const char** string)
+{
+    const char* s = *string;
+    quint64 value = 0;
+    while (*s >= '0' && *s <= '9') {
+        value = value * 10 + (*s++ - '0');
+    }
+    *string = s;
+    return value;
 }
 
 void EventUtilsPrivate::updateCpuUsage(UMEvent* event)
@@ -73,9 +156,10 @@ void EventUtilsPrivate::updateCpuUsage(UMEvent* event)
     // times() is a Linux syscall giving CPU times used by the process. The
     // granularity of the unit returned by the (some?) kernel (clock ticks)
     // prevents us from getting precise timings at a high frequency, so we have
-    // to throttle to 200 ms (5 Hz).
+    // to throttle to 200 ms (5 Hz). The same applies to per-thread CPU times.
     const qint64 throttlingFrequency = 200;
-    if (m_cpuTimer.elapsed() > throttlingFrequency) {
+    const qint64 elapsed = m_cpuTimer.elapsed();
+    if (elapsed > throttlingFrequency) {
         struct tms newCpuTimes;
         const clock_t newTicks = times(&newCpuTimes);
         const clock_t ticks = newTicks - m_cpuTicks;
@@ -85,64 +169,208 @@ void EventUtilsPrivate::updateCpuUsage(UMEvent* event)
         m_cpuTimer.start();
         memcpy(&m_cpuTimes, &newCpuTimes, sizeof(struct tms));
         m_cpuTicks = newTicks;
+        updateThreadCpuUsage(event, elapsed);
+    }
+}
+
+// Parses the CPU time in clock ticks (user and system) of a /proc stat file
+// read in the buffer. Returns false on error.
+static bool parseStatCpuTicks(const char* buffer, quint64* ticks)
+{
+    // Entries starting from 1 (as listed by 'man proc').
+    const int utimeEntry = 14;
+    const char* entries = statEntries(buffer);
+    if (entries && (entries = skipEntries(entries, utimeEntry - 3))) {
+        const quint64 userTime = parseUnsigned(&entries);
+        if (*entries++ == ' ') {
+            *ticks = userTime + parseUnsigned(&entries);
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventUtilsPrivate::updateThreadCpuUsage(UMEvent* event, qint64 elapsed)
+{
+    DASSERT(elapsed > 0);
+
+    // Accumulate the CPU time used by the known threads since last update.
+    quint64 ticks[ThreadTypeCount] = {};
+    for (int i = 0; i < m_threadCount; ++i) {
+        quint64 threadTicks;
+        if (readProcFile(m_threads[i].fd) > 0 && parseStatCpuTicks(m_buffer, &threadTicks)) {
+            ticks[m_threads[i].type] += threadTicks - m_threads[i].ticks;
+            m_threads[i].ticks = threadTicks;
+        }
+    }
+    updateThreads();
+
+    quint16* usage[ThreadTypeCount] = {
+        &event->process.guiThreadCpuUsage, &event->process.renderThreadCpuUsage,
+        &event->process.loaderThreadCpuUsage, &event->process.otherThreadCpuUsage
+    };
+    for (int i = 0; i < ThreadTypeCount; ++i) {
+        *usage[i] = qMin<quint64>(
+            (ticks[i] * 100 * 1000) / (elapsed * m_clockTicksPerSecond), 0xffff);
+    }
+}
+
+// Updates the list of threads, opening the stat files of new threads and
+// closing the ones of terminated threads.
+void EventUtilsPrivate::updateThreads()
+{
+    DIR* directory = opendir("/proc/self/task");
+    if (!directory) {
+        DWARN("EventUtils: can't open '/proc/self/task'");
+        return;
+    }
+
+    for (int i = 0; i < m_threadCount; ++i) {
+        m_threads[i].alive = false;
+    }
+    while (struct dirent* entry = readdir(directory)) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+            continue;
+        }
+        const char* name = entry->d_name;
+        const pid_t tid = parseUnsigned(&name);
+        bool found = false;
+        for (int i = 0; i < m_threadCount; ++i) {
+            if (m_threads[i].tid == tid) {
+                m_threads[i].alive = true;
+                found = true;
+                break;
+            }
+        }
+        if (found || m_threadCount == maxThreads) {
+            continue;
+        }
+
+        char path[sizeof("/proc/self/task//stat") + 10];
+        snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+        const int fd = open(path, O_RDONLY | O_CLOEXEC);
+        quint64 threadTicks;
+        if (fd == -1) {
+            continue;
+        } else if (readProcFile(fd) <= 0 || !parseStatCpuTicks(m_buffer, &threadTicks)) {
+            close(fd);
+            continue;
+        }
+
+        // The command name is the thread name set by QThread (truncated to
+        // 15 characters by the kernel).
+        quint8 type = OtherThread;
+        const char* threadName = strchr(m_buffer, '(');
+        if (tid == m_pid) {
+            type = GuiThread;
+        } else if (threadName) {
+            threadName++;
+            if (!strncmp(threadName, "QSGRenderThread", sizeof("QSGRenderThread") - 1)) {
+                type = RenderThread;
+            } else if (!strncmp(threadName, "QQmlThread", sizeof("QQmlThread") - 1)
+                       || !strncmp(threadName, "QQuickPixmapRea", sizeof("QQuickPixmapRea") - 1)) {
+                type = LoaderThread;
+            }
+        }
+        m_threads[m_threadCount].fd = fd;
+        m_threads[m_threadCount].tid = tid;
+        m_threads[m_threadCount].ticks = threadTicks;
+        m_threads[m_threadCount].type = type;
+        m_threads[m_threadCount].alive = true;
+        m_threadCount++;
+    }
+    closedir(directory);
+
+    // Remove terminated threads.
+    for (int i = 0; i < m_threadCount; ) {
+        if (!m_threads[i].alive) {
+            close(m_threads[i].fd);
+            if (i < --m_threadCount) {
+                memcpy(&m_threads[i], &m_threads[m_threadCount], sizeof(m_threads[0]));
+            }
+        } else {
+            ++i;
+        }
     }
 }
 
 void EventUtilsPrivate::updateProcStatMetrics(UMEvent* event)
 {
-    int fd = open("/proc/self/stat", O_RDONLY);
-    if (fd == -1) {
-        DWARN("EventUtils: can't open '/proc/self/stat'");
+    if (m_statFd == -1) {
         return;
     }
-    int readSize;
-    if ((readSize = read(fd, m_buffer, bufferSize)) == 0) {
+    if (readProcFile(m_statFd) == -1) {
         DWARN("EventUtils: can't read '/proc/self/stat'");
-        close(fd);
         return;
     }
 
     // Entries starting from 1 (as listed by 'man proc').
     const int numThreadsEntry = 20;
     const int vsizeEntry = 23;
-    const int rssEntry = 24;
-    const int lastEntry = rssEntry;
-
-    // Get the indices of num_threads, vsize and rss entries and check if
-    // the buffer is big enough.
-    int sourceIndex = 0, spaceCount = 0;
-    quint16 entryIndices[lastEntry + 1];
-    entryIndices[sourceIndex] = 0;
-    while (spaceCount < lastEntry) {
-        if (sourceIndex < readSize) {
-            if (m_buffer[sourceIndex++] == ' ') {
-                entryIndices[++spaceCount] = sourceIndex;
-            }
-        } else {
-            DASSERT(readSize == bufferSize); // Missing entries in /proc/self/stat.
-            DNOT_REACHED();  // Consider increasing bufferSize.
-            close(fd);
-            return;
-        }
-    }
 
-    unsigned long vsize;
-    long threadCount, rss;
-#if !defined(QT_NO_DEBUG)
-    int value =  sscanf(&m_buffer[entryIndices[numThreadsEntry-1]], "%ld", &threadCount);
-    ASSERT(value == 1);
-    value =  sscanf(&m_buffer[entryIndices[vsizeEntry-1]], "%lu %ld", &vsize, &rss);
-    ASSERT(value == 2);
-#else
-    sscanf(&m_buffer[entryIndices[numThreadsEntry-1]], "%ld", &threadCount);
-    sscanf(&m_buffer[entryIndices[vsizeEntry-1]], "%lu %ld", &vsize, &rss);
-#endif
+    const char* entries = statEntries(m_buffer);
+    if (!entries || !(entries = skipEntries(entries, numThreadsEntry - 3))) {
+        DNOT_REACHED();  // Missing entries in /proc/self/stat.
+        return;
+    }
+    const quint64 threadCount = parseUnsigned(&entries);
+    if (!(entries = skipEntries(entries, vsizeEntry - numThreadsEntry))) {
+        DNOT_REACHED();  // Missing entries in /proc/self/stat.
+        return;
+    }
+    const quint64 vsize = parseUnsigned(&entries);
+    entries++;
+    const quint64 rss = parseUnsigned(&entries);
 
     event->process.vszMemory = vsize >> 10;
     event->process.rssMemory = (rss * m_pageSize) >> 10;
     event->process.threadCount = threadCount;
+}
+
+void EventUtilsPrivate::updateResourceUsageMetrics(UMEvent* event)
+{
+    // getrusage() gives page faults and context switches summed over all the
+    // threads of the process.
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == -1) {
+        DWARN("EventUtils: can't get resource usage");
+        return;
+    }
+    event->process.minorFaults = usage.ru_minflt - m_minorFaults;
+    event->process.majorFaults = usage.ru_majflt - m_majorFaults;
+    event->process.voluntaryContextSwitches = usage.ru_nvcsw - m_voluntaryContextSwitches;
+    event->process.involuntaryContextSwitches = usage.ru_nivcsw - m_involuntaryContextSwitches;
+    m_minorFaults = usage.ru_minflt;
+    m_majorFaults = usage.ru_majflt;
+    m_voluntaryContextSwitches = usage.ru_nvcsw;
+    m_involuntaryContextSwitches = usage.ru_nivcsw;
+}
 
-    close(fd);
+// Parses the value in kB of a field of /proc/self/smaps_rollup read in the
+// buffer, 0 if not found.
+static quint64 smapsValue(const char* buffer, const char* field)
+{
+    const char* line = strstr(buffer, field);
+    if (!line) {
+        return 0;
+    }
+    line += strlen(field);
+    while (*line == ' ') {
+        line++;
+    }
+    return parseUnsigned(&line);
+}
+
+void EventUtilsPrivate::updateSmapsMetrics(UMEvent* event)
+{
+    // The kernel walks all the mappings to generate smaps_rollup, it's
+    // expensive but cheaper than reading smaps and does not allocate.
+    if (m_smapsFd == -1 || readProcFile(m_smapsFd) == -1) {
+        return;
+    }
+    event->process.pssMemory = smapsValue(m_buffer, "\nPss:");
+    event->process.ussMemory =
+        smapsValue(m_buffer, "\nPrivate_Clean:") + smapsValue(m_buffer, "\nPrivate_Dirty:");
 }
 
 // static.
@@ -39,9 +39,37 @@ struct UBUNTU_METRICS_EXPORT UMProcessEvent
     // Number of threads at buffer swap.
     quint16 threadCount;
 
+    // Number of events dropped by the application monitor because the logging
+    // queue was full since logging started.
+    quint32 droppedEvents;
+
+    // Proportional set size (PSS) of the process in kilobytes, 0 if not
+    // available.
+    quint32 pssMemory;
+
+    // Unique set size (USS) of the process in kilobytes, 0 if not available.
+    quint32 ussMemory;
+
+    // Number of minor and major page faults since the previous process event.
+    quint32 minorFaults;
+    quint32 majorFaults;
+
+    // Number of voluntary and involuntary context switches of all the threads
+    // since the previous process event.
+    quint32 voluntaryContextSwitches;
+    quint32 involuntaryContextSwitches;
+
+    // CPU usage of the GUI thread, the QtQuick render threads, the QML loader
+    // threads (QML and image loaders) and of the remaining threads as a
+    // percentage of one core. 100% if a single thread uses a full core.
+    quint16 guiThreadCpuUsage;
+    quint16 renderThreadCpuUsage;
+    quint16 loaderThreadCpuUsage;
+    quint16 otherThreadCpuUsage;
+
     // The whole struct must take 112 bytes to allow future additions and best
     // memory alignment, don't forget to update when adding new metrics.
-    quint8 __reserved[/*12 bytes taken,*/ 100 /*bytes free*/];
+    quint8 __reserved[/*48 bytes taken,*/ 64 /*bytes free*/];
 };
 Q_STATIC_ASSERT(sizeof(UMProcessEvent) == 112);
 
@@ -118,9 +146,39 @@ struct UBUNTU_METRICS_EXPORT UMGenericEvent
 };
 Q_STATIC_ASSERT(sizeof(UMGenericEvent) == 112);
 
+struct UBUNTU_METRICS_EXPORT UMFrameSummaryEvent
+{
+    enum Metric {
+        DeltaTime = 0, SyncTime = 1, RenderTime = 2, GpuTime = 3, SwapTime = 4, MetricCount = 5
+    };
+    enum Statistic { P50 = 0, P90 = 1, P99 = 2, Max = 3, StatisticCount = 4 };
+
+    // The id of the window on which the frames have been rendered.
+    quint32 window;
+
+    // Number of frames rendered during the summarized period.
+    quint32 frameCount;
+
+    // Number of frames whose delta time exceeded one and a half the refresh
+    // interval of the screen the window is shown on.
+    quint32 missedVsyncCount;
+
+    // Frame time statistics in nanoseconds indexed by metric and statistic
+    // (percentiles are approximated by the upper bound of a log-linear
+    // histogram bucket with a maximum relative error of 1/16).
+    quint32 times[MetricCount][StatisticCount];
+
+    // The whole struct must take 112 bytes to allow future additions and best
+    // memory alignment, don't forget to update when adding new metrics.
+    quint8 __reserved[/*92 bytes taken,*/ 20 /*bytes free*/];
+};
+Q_STATIC_ASSERT(sizeof(UMFrameSummaryEvent) == 112);
+
 struct UBUNTU_METRICS_EXPORT UMEvent
 {
-    enum Type { Process = 0, Window = 1, Frame = 2, Generic = 3, TypeCount = 4 };
+    enum Type {
+        Process = 0, Window = 1, Frame = 2, Generic = 3, FrameSummary = 4, TypeCount = 5
+    };
 
     // Event type.
     Type type;
@@ -133,6 +191,7 @@ struct UBUNTU_METRICS_EXPORT UMEvent
         UMWindowEvent window;
         UMFrameEvent frame;
         UMGenericEvent generic;
+        UMFrameSummaryEvent frameSummary;
     };
 };
 Q_STATIC_ASSERT(sizeof(UMEvent) == 128);
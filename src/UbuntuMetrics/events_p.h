@@ -21,6 +21,7 @@
 #include <UbuntuMetrics/events.h>
 
 #include <sys/times.h>
+#include <sys/types.h>
 
 #include <QtCore/QElapsedTimer>
 
@@ -29,16 +30,43 @@
 class UBUNTU_METRICS_PRIVATE_EXPORT EventUtilsPrivate
 {
 public:
+    enum ThreadType { GuiThread = 0, RenderThread, LoaderThread, OtherThread, ThreadTypeCount };
+    static const int maxThreads = 64;
+
     EventUtilsPrivate();
     ~EventUtilsPrivate();
 
     void updateCpuUsage(UMEvent* event);
+    void updateThreadCpuUsage(UMEvent* event, qint64 elapsed);
+    void updateThreads();
     void updateProcStatMetrics(UMEvent* event);
+    void updateResourceUsageMetrics(UMEvent* event);
+    void updateSmapsMetrics(UMEvent* event);
+    int readProcFile(int fd);
+
+    // /proc/self/task/<tid>/stat files are kept open for the lifetime of the
+    // threads.
+    struct {
+        int fd;
+        pid_t tid;
+        quint64 ticks;
+        quint8 type;
+        bool alive;
+    } m_threads[maxThreads];
 
     char* m_buffer;
     QElapsedTimer m_cpuTimer;
     struct tms m_cpuTimes;
     clock_t m_cpuTicks;
+    quint64 m_minorFaults;
+    quint64 m_majorFaults;
+    quint64 m_voluntaryContextSwitches;
+    quint64 m_involuntaryContextSwitches;
+    long m_clockTicksPerSecond;
+    pid_t m_pid;
+    int m_threadCount;
+    int m_statFd;
+    int m_smapsFd;
     quint16 m_cpuOnlineCores;
     quint16 m_pageSize;
 };
@@ -0,0 +1,97 @@
+// Copyright © 2016 Canonical Ltd.
+//
+// This file is part of Ubuntu UI Toolkit.
+//
+// Ubuntu UI Toolkit is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; version 3.
+//
+// Ubuntu UI Toolkit is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Ubuntu UI Toolkit. If not, see <http://www.gnu.org/licenses/>.
+
+#include "histogram_p.h"
+
+// Percentiles in the order of UMFrameSummaryEvent::Statistic.
+static const quint32 percentiles[] = { 50, 90, 99 };
+Q_STATIC_ASSERT(ARRAY_SIZE(percentiles) == UMFrameSummaryEvent::Max);
+
+FrameHistogram::FrameHistogram()
+    : m_max(0)
+{
+    for (int i = 0; i < bucketCount; ++i) {
+        m_counts[i].store(0);
+    }
+}
+
+// Values lower than subBucketCount have their own bucket, bigger values are
+// stored in the bucket of their most significant bit refined by the
+// subBucketBits bits following it.
+int FrameHistogram::bucketIndex(quint32 value)
+{
+    if (value < subBucketCount) {
+        return value;
+    }
+    const int msb = 31 - __builtin_clz(value);
+    const int exponent = msb - subBucketBits + 1;
+    const int subBucket = (value >> (msb - subBucketBits)) & (subBucketCount - 1);
+    return exponent * subBucketCount + subBucket;
+}
+
+quint32 FrameHistogram::bucketUpperBound(int index)
+{
+    DASSERT(index >= 0 && index < bucketCount);
+
+    const int exponent = index / subBucketCount;
+    const quint32 subBucket = index % subBucketCount;
+    if (exponent == 0) {
+        return subBucket;
+    }
+    const quint32 width = 1u << (exponent - 1);
+    return ((subBucketCount + subBucket) << (exponent - 1)) + (width - 1);
+}
+
+void FrameHistogram::record(quint64 time)
+{
+    const quint32 value = static_cast<quint32>(qMin<quint64>(time, 0xffffffffu));
+    m_counts[bucketIndex(value)].fetchAndAddRelaxed(1);
+    quint32 max = m_max.load();
+    while (value > max && !m_max.testAndSetRelaxed(max, value, max)) {}
+}
+
+quint32 FrameHistogram::statistics(quint32* times, bool reset)
+{
+    DASSERT(times);
+
+    quint32 counts[bucketCount];
+    quint32 total = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        counts[i] = reset ? m_counts[i].fetchAndStoreRelaxed(0) : m_counts[i].load();
+        total += counts[i];
+    }
+    const quint32 max = reset ? m_max.fetchAndStoreRelaxed(0) : m_max.load();
+
+    if (total == 0) {
+        memset(times, 0, UMFrameSummaryEvent::StatisticCount * sizeof(quint32));
+        return 0;
+    }
+
+    // Walk the buckets once, percentiles being sorted.
+    quint32 cumulativeCount = 0;
+    int bucket = 0;
+    for (int i = 0; i < UMFrameSummaryEvent::Max; ++i) {
+        const quint32 rank = qMax<quint32>(
+            (static_cast<quint64>(total) * percentiles[i] + 99) / 100, 1u);
+        while (cumulativeCount + counts[bucket] < rank && bucket < bucketCount - 1) {
+            cumulativeCount += counts[bucket++];
+        }
+        times[i] = qMin(bucketUpperBound(bucket), max);
+    }
+    times[UMFrameSummaryEvent::Max] = max;
+
+    return total;
+}
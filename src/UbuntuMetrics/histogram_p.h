@@ -0,0 +1,56 @@
+// Copyright © 2016 Canonical Ltd.
+//
+// This file is part of Ubuntu UI Toolkit.
+//
+// Ubuntu UI Toolkit is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; version 3.
+//
+// Ubuntu UI Toolkit is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Ubuntu UI Toolkit. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HISTOGRAM_P_H
+#define HISTOGRAM_P_H
+
+#include <QtCore/QAtomicInteger>
+
+#include <UbuntuMetrics/events.h>
+#include <UbuntuMetrics/private/ubuntumetricsglobal_p.h>
+
+// Log-linear histogram of times in nanoseconds (HDR style). Values are stored
+// in buckets covering power-of-two ranges split in 16 linear sub-buckets,
+// which bounds the relative error to 1/16 up to ~4.3 seconds. Recording is
+// wait-free and can be done concurrently with statistics queries from another
+// thread.
+class UBUNTU_METRICS_PRIVATE_EXPORT FrameHistogram
+{
+public:
+    static const int subBucketBits = 4;
+    static const int subBucketCount = 1 << subBucketBits;
+    static const int bucketCount = (32 - subBucketBits + 1) * subBucketCount;
+
+    FrameHistogram();
+
+    // Records a time in nanoseconds, bigger values are clamped.
+    void record(quint64 time);
+
+    // Fills times (indexed by UMFrameSummaryEvent::Statistic) with the
+    // percentiles and the max of the recorded values and returns the value
+    // count. Values are atomically removed from the histogram if reset is
+    // true.
+    quint32 statistics(quint32* times, bool reset);
+
+private:
+    static int bucketIndex(quint32 value);
+    static quint32 bucketUpperBound(int index);
+
+    QAtomicInteger<quint32> m_counts[bucketCount];
+    QAtomicInteger<quint32> m_max;
+};
+
+#endif  // HISTOGRAM_P_H
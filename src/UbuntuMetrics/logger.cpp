@@ -18,8 +18,18 @@
 #include "logger_p.h"
 
 #include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
+#include <atomic>
+
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QTime>
 
 #include "events.h"
@@ -48,7 +58,7 @@ UMFileLoggerPrivate::UMFileLoggerPrivate(const QString& fileName, bool parsable)
         m_textStream.setCodec("ISO 8859-1");
         m_textStream.setRealNumberPrecision(2);
         m_textStream.setRealNumberNotation(QTextStream::FixedNotation);
-        m_flags = Open | Parsable;
+        m_flags = Open;
         if (parsable) {
             m_flags |= Parsable;
         }
@@ -127,7 +137,18 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
                     << event.process.cpuUsage << ' '
                     << event.process.vszMemory << ' '
                     << event.process.rssMemory << ' '
-                    << event.process.threadCount << '\n' << flush;
+                    << event.process.threadCount << ' '
+                    << event.process.droppedEvents << ' '
+                    << event.process.pssMemory << ' '
+                    << event.process.ussMemory << ' '
+                    << event.process.minorFaults << ' '
+                    << event.process.majorFaults << ' '
+                    << event.process.voluntaryContextSwitches << ' '
+                    << event.process.involuntaryContextSwitches << ' '
+                    << event.process.guiThreadCpuUsage << ' '
+                    << event.process.renderThreadCpuUsage << ' '
+                    << event.process.loaderThreadCpuUsage << ' '
+                    << event.process.otherThreadCpuUsage << '\n' << flush;
             } else {
                 m_textStream
                     << (m_flags & Colored ? "\033[33mP\033[00m " : "P ")
@@ -135,7 +156,18 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
                     << "CPU" << dimColon << event.process.cpuUsage << "% "
                     << "VSZ" << dimColon << event.process.vszMemory << "kB "
                     << "RSS" << dimColon << event.process.rssMemory << "kB "
-                    << "Threads" << dimColon << event.process.threadCount
+                    << "Threads" << dimColon << event.process.threadCount << ' '
+                    << "Dropped" << dimColon << event.process.droppedEvents << ' '
+                    << "PSS" << dimColon << event.process.pssMemory << "kB "
+                    << "USS" << dimColon << event.process.ussMemory << "kB "
+                    << "MinFlt" << dimColon << event.process.minorFaults << ' '
+                    << "MajFlt" << dimColon << event.process.majorFaults << ' '
+                    << "VolCS" << dimColon << event.process.voluntaryContextSwitches << ' '
+                    << "InvolCS" << dimColon << event.process.involuntaryContextSwitches << ' '
+                    << "GUI" << dimColon << event.process.guiThreadCpuUsage << "% "
+                    << "Render" << dimColon << event.process.renderThreadCpuUsage << "% "
+                    << "Loader" << dimColon << event.process.loaderThreadCpuUsage << "% "
+                    << "Other" << dimColon << event.process.otherThreadCpuUsage << '%'
                     << '\n' << flush;
             }
             break;
@@ -208,6 +240,43 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
             break;
         }
 
+        case UMEvent::FrameSummary: {
+            const UMFrameSummaryEvent& summary = event.frameSummary;
+            if (m_flags & Parsable) {
+                m_textStream
+                    << "S "
+                    << event.timeStamp << ' '
+                    << summary.window << ' '
+                    << summary.frameCount << ' '
+                    << summary.missedVsyncCount;
+                for (int i = 0; i < UMFrameSummaryEvent::MetricCount; ++i) {
+                    for (int j = 0; j < UMFrameSummaryEvent::StatisticCount; ++j) {
+                        m_textStream << ' ' << summary.times[i][j];
+                    }
+                }
+                m_textStream << '\n' << flush;
+            } else {
+                const char* const metricString[] = { "Delta", "Sync", "Render", "GPU", "Swap" };
+                Q_STATIC_ASSERT(ARRAY_SIZE(metricString) == UMFrameSummaryEvent::MetricCount);
+                m_textStream
+                    << (m_flags & Colored ? "\033[34mS\033[00m " : "S ")
+                    << dim << timeString << reset << ' '
+                    << "Win" << dimColon << summary.window << ' '
+                    << "Frames" << dimColon << summary.frameCount << ' '
+                    << "Missed" << dimColon << summary.missedVsyncCount;
+                // Percentiles 50, 90, 99 and max.
+                for (int i = 0; i < UMFrameSummaryEvent::MetricCount; ++i) {
+                    m_textStream << ' ' << metricString[i] << dimColon;
+                    for (int j = 0; j < UMFrameSummaryEvent::StatisticCount; ++j) {
+                        m_textStream << (j > 0 ? "/" : "") << summary.times[i][j] / 1000000.0f;
+                    }
+                    m_textStream << "ms";
+                }
+                m_textStream << '\n' << flush;
+            }
+            break;
+        }
+
         default:
             DNOT_REACHED();
             break;
@@ -231,6 +300,220 @@ bool UMFileLogger::parsable()
     return !!(d_func()->m_flags & UMFileLoggerPrivate::Parsable);
 }
 
+const int batchAlignment = 64;
+
+UMBinaryFileLogger::UMBinaryFileLogger(const QString& fileName)
+    : d_ptr(new UMBinaryFileLoggerPrivate(fileName))
+{
+}
+
+UMBinaryFileLoggerPrivate::UMBinaryFileLoggerPrivate(const QString& fileName)
+    : m_batch(nullptr)
+    , m_batchSize(0)
+{
+    const QString filePath = QDir::isRelativePath(fileName)
+        ? QString(QDir::currentPath() + QDir::separator() + fileName) : fileName;
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    m_batchCapacity = qMax(pageSize, static_cast<long>(sizeof(UMEvent))) / sizeof(UMEvent);
+
+    m_fd = open(QFile::encodeName(filePath).constData(),
+                O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd == -1) {
+        WARN("BinaryFileLogger: Can't open file '%s' (%s).", filePath.toLatin1().constData(),
+             strerror(errno));
+        return;
+    }
+
+    UMBinaryFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = UMBinaryFileHeader::magicNumber;
+    header.version = UMBinaryFileHeader::currentVersion;
+    header.clockSource = QElapsedTimer::clockType();
+    header.pageSize = m_batchCapacity * sizeof(UMEvent);
+    header.eventSize = sizeof(UMEvent);
+    if (!write(&header, sizeof(header))) {
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    m_batch = static_cast<UMEvent*>(
+        alignedAlloc(batchAlignment, m_batchCapacity * sizeof(UMEvent)));
+}
+
+UMBinaryFileLogger::~UMBinaryFileLogger()
+{
+    delete d_ptr;
+}
+
+UMBinaryFileLoggerPrivate::~UMBinaryFileLoggerPrivate()
+{
+    if (m_fd != -1) {
+        flush();
+        close(m_fd);
+    }
+    free(m_batch);
+}
+
+bool UMBinaryFileLogger::isOpen()
+{
+    return d_func()->m_fd != -1;
+}
+
+void UMBinaryFileLogger::log(const UMEvent& event)
+{
+    d_func()->log(event);
+}
+
+void UMBinaryFileLoggerPrivate::log(const UMEvent& event)
+{
+    if (m_fd != -1) {
+        DASSERT(m_batchSize < m_batchCapacity);
+        memcpy(&m_batch[m_batchSize++], &event, sizeof(UMEvent));
+        if (m_batchSize == m_batchCapacity) {
+            flush();
+        }
+    }
+}
+
+void UMBinaryFileLogger::flush()
+{
+    d_func()->flush();
+}
+
+void UMBinaryFileLoggerPrivate::flush()
+{
+    if (m_fd != -1 && m_batchSize > 0) {
+        write(m_batch, m_batchSize * sizeof(UMEvent));
+        m_batchSize = 0;
+    }
+}
+
+bool UMBinaryFileLoggerPrivate::write(const void* data, size_t size)
+{
+    DASSERT(m_fd != -1);
+
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(m_fd, bytes, size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            DWARN("BinaryFileLogger: Can't write to file (%s).", strerror(errno));
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+UMFlightRecorderLogger::UMFlightRecorderLogger(
+    quint32 duration, quint32 eventsPerSecond, const QString& fileName)
+    : d_ptr(new UMFlightRecorderLoggerPrivate(duration, eventsPerSecond, fileName))
+{
+}
+
+UMFlightRecorderLoggerPrivate::UMFlightRecorderLoggerPrivate(
+    quint32 duration, quint32 eventsPerSecond, const QString& fileName)
+    : m_header(nullptr)
+    , m_events(nullptr)
+    , m_mappingSize(0)
+    , m_index(0)
+{
+    if (fileName.isEmpty()) {
+        QString directory = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+        if (directory.isEmpty()) {
+            directory = QDir::tempPath();
+        }
+        m_fileName = QStringLiteral("%1/ubuntu-metrics-%2-%3.flight").arg(directory).arg(
+            QCoreApplication::applicationName()).arg(QCoreApplication::applicationPid());
+    } else if (QDir::isRelativePath(fileName)) {
+        m_fileName = QString(QDir::currentPath() + QDir::separator() + fileName);
+    } else {
+        m_fileName = fileName;
+    }
+
+    // Round the capacity up to a power-of-two so that indexing the circular
+    // buffer is a simple mask.
+    const quint32 minCapacity = qMax(duration, 1u) * qMax(eventsPerSecond, 1u);
+    m_capacity = 1;
+    while (m_capacity < minCapacity && m_capacity < (1u << 24)) {
+        m_capacity <<= 1;
+    }
+
+    const int fd = open(QFile::encodeName(m_fileName).constData(),
+                        O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        WARN("FlightRecorderLogger: Can't open file '%s' (%s).",
+             m_fileName.toLatin1().constData(), strerror(errno));
+        return;
+    }
+    m_mappingSize = sizeof(UMBinaryFileHeader) + m_capacity * sizeof(UMEvent);
+    if (ftruncate(fd, m_mappingSize) == -1) {
+        WARN("FlightRecorderLogger: Can't resize file '%s' (%s).",
+             m_fileName.toLatin1().constData(), strerror(errno));
+        close(fd);
+        return;
+    }
+    void* mapping = mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps a reference to the file.
+    if (mapping == MAP_FAILED) {
+        WARN("FlightRecorderLogger: Can't map file '%s' (%s).",
+             m_fileName.toLatin1().constData(), strerror(errno));
+        return;
+    }
+
+    m_header = static_cast<UMBinaryFileHeader*>(mapping);
+    m_events = reinterpret_cast<UMEvent*>(static_cast<char*>(mapping) + sizeof(UMBinaryFileHeader));
+    m_header->magic = UMBinaryFileHeader::magicNumber;
+    m_header->version = UMBinaryFileHeader::currentVersion;
+    m_header->clockSource = QElapsedTimer::clockType();
+    m_header->pageSize = sysconf(_SC_PAGESIZE);
+    m_header->eventSize = sizeof(UMEvent);
+    m_header->ringCapacity = m_capacity;
+    m_header->ringIndex = 0;
+    m_header->ringDuration = qMax(duration, 1u) * 1000;
+}
+
+UMFlightRecorderLogger::~UMFlightRecorderLogger()
+{
+    delete d_ptr;
+}
+
+UMFlightRecorderLoggerPrivate::~UMFlightRecorderLoggerPrivate()
+{
+    if (m_header) {
+        munmap(m_header, m_mappingSize);
+    }
+}
+
+bool UMFlightRecorderLogger::isOpen()
+{
+    return !!d_func()->m_header;
+}
+
+QString UMFlightRecorderLogger::fileName()
+{
+    return d_func()->m_fileName;
+}
+
+void UMFlightRecorderLogger::log(const UMEvent& event)
+{
+    d_func()->log(event);
+}
+
+void UMFlightRecorderLoggerPrivate::log(const UMEvent& event)
+{
+    if (m_header) {
+        memcpy(&m_events[m_index & (m_capacity - 1)], &event, sizeof(UMEvent));
+        // Publish the record to live readers only once it's fully written.
+        std::atomic_thread_fence(std::memory_order_release);
+        m_header->ringIndex = ++m_index;
+    }
+}
+
 #if defined(Q_OS_LINUX)
 
 UMLTTNGPlugin* UMLTTNGLogger::m_plugin = nullptr;
@@ -274,7 +557,18 @@ void UMLTTNGLogger::log(const UMEvent& event)
                 .vszMemory = event.process.vszMemory,
                 .rssMemory = event.process.rssMemory,
                 .cpuUsage = event.process.cpuUsage,
-                .threadCount = event.process.threadCount
+                .threadCount = event.process.threadCount,
+                .droppedEvents = event.process.droppedEvents,
+                .pssMemory = event.process.pssMemory,
+                .ussMemory = event.process.ussMemory,
+                .minorFaults = event.process.minorFaults,
+                .majorFaults = event.process.majorFaults,
+                .voluntaryContextSwitches = event.process.voluntaryContextSwitches,
+                .involuntaryContextSwitches = event.process.involuntaryContextSwitches,
+                .guiThreadCpuUsage = event.process.guiThreadCpuUsage,
+                .renderThreadCpuUsage = event.process.renderThreadCpuUsage,
+                .loaderThreadCpuUsage = event.process.loaderThreadCpuUsage,
+                .otherThreadCpuUsage = event.process.otherThreadCpuUsage
             };
             m_plugin->logProcessEvent(&processEvent);
             break;
@@ -316,6 +610,10 @@ void UMLTTNGLogger::log(const UMEvent& event)
             break;
         }
 
+        case UMEvent::FrameSummary:
+            // Not supported by the LTTng tracepoints.
+            break;
+
         default:
             DNOT_REACHED();
             break;
@@ -23,6 +23,8 @@
 #include <UbuntuMetrics/ubuntumetricsglobal.h>
 
 class UMFileLoggerPrivate;
+class UMBinaryFileLoggerPrivate;
+class UMFlightRecorderLoggerPrivate;
 struct UMLTTNGPlugin;
 struct UMEvent;
 
@@ -58,6 +60,96 @@ private:
     Q_DECLARE_PRIVATE(UMFileLogger)
 };
 
+// Header of the binary files written by UMBinaryFileLogger and
+// UMFlightRecorderLogger. The header is followed by the UMEvent records stored
+// as is, in native byte order.
+struct UBUNTU_METRICS_EXPORT UMBinaryFileHeader
+{
+    static const quint32 magicNumber = 0x52544d55;  // "UMTR" in little-endian.
+    static const quint32 currentVersion = 1;
+
+    // Must be equal to magicNumber.
+    quint32 magic;
+
+    // Version of the file format.
+    quint32 version;
+
+    // Clock used to generate the event time stamps, as returned by
+    // QElapsedTimer::clockType().
+    quint32 clockSource;
+
+    // Size in bytes of the batches of events written at once.
+    quint32 pageSize;
+
+    // Size in bytes of an event record.
+    quint32 eventSize;
+
+    // Number of records in the circular buffer of flight recorder files, 0
+    // for files storing records linearly.
+    quint32 ringCapacity;
+
+    // Number of records written since the creation of a flight recorder file.
+    // The oldest record is at index max(0, ringIndex - ringCapacity) modulo
+    // ringCapacity.
+    quint64 ringIndex;
+
+    // Duration in milliseconds covered by a flight recorder file. Records older
+    // than that duration relative to the last record are outdated.
+    quint32 ringDuration;
+
+    // The whole struct must take 128 bytes (the size of an event record) so
+    // that records are aligned, don't forget to update when adding new fields.
+    quint8 __reserved[/*36 bytes taken,*/ 92 /*bytes free*/];
+};
+Q_STATIC_ASSERT(sizeof(UMBinaryFileHeader) == 128);
+
+// Log events to a file in a binary format. Events are copied to a page sized
+// buffer and written in batches, the buffer is flushed when full and at
+// destruction. Use the ubuntu-metrics-converter tool to convert binary files
+// to the text format of UMFileLogger.
+class UBUNTU_METRICS_EXPORT UMBinaryFileLogger : public UMLogger
+{
+public:
+    UMBinaryFileLogger(const QString& fileName);
+    ~UMBinaryFileLogger();
+
+    void log(const UMEvent& event) Q_DECL_OVERRIDE;
+    bool isOpen() Q_DECL_OVERRIDE;
+
+    // Write the events pending in the current batch.
+    void flush();
+
+private:
+    UMBinaryFileLoggerPrivate* const d_ptr;
+    Q_DECLARE_PRIVATE(UMBinaryFileLogger)
+};
+
+// Log the events of the last seconds to a circular buffer memory mapped to a
+// file, by default in the user runtime directory (XDG_RUNTIME_DIR). The file
+// is left behind at exit, so that a crashed or janky application can be
+// analysed post-mortem at the cost of a memcpy per event. Use the
+// ubuntu-metrics-converter tool to dump the events in chronological order.
+class UBUNTU_METRICS_EXPORT UMFlightRecorderLogger : public UMLogger
+{
+public:
+    // duration is the number of seconds kept, eventsPerSecond is the maximum
+    // event rate expected to size the buffer. An empty file name creates a
+    // file named after the application name and the process id.
+    UMFlightRecorderLogger(quint32 duration = 10, quint32 eventsPerSecond = 128,
+                           const QString& fileName = QString());
+    ~UMFlightRecorderLogger();
+
+    void log(const UMEvent& event) Q_DECL_OVERRIDE;
+    bool isOpen() Q_DECL_OVERRIDE;
+
+    // Get the absolute file name of the flight recorder file.
+    QString fileName();
+
+private:
+    UMFlightRecorderLoggerPrivate* const d_ptr;
+    Q_DECLARE_PRIVATE(UMFlightRecorderLogger)
+};
+
 #if defined(Q_OS_LINUX)
 
 // Log events to LTTng.
@@ -45,4 +45,37 @@ public:
     quint8 m_flags;
 };
 
+class UBUNTU_METRICS_PRIVATE_EXPORT UMBinaryFileLoggerPrivate
+{
+public:
+    UMBinaryFileLoggerPrivate(const QString& fileName);
+    ~UMBinaryFileLoggerPrivate();
+
+    void log(const UMEvent& event);
+    void flush();
+    bool write(const void* data, size_t size);
+
+    UMEvent* m_batch;
+    int m_fd;
+    quint32 m_batchCapacity;
+    quint32 m_batchSize;
+};
+
+class UBUNTU_METRICS_PRIVATE_EXPORT UMFlightRecorderLoggerPrivate
+{
+public:
+    UMFlightRecorderLoggerPrivate(quint32 duration, quint32 eventsPerSecond,
+                                  const QString& fileName);
+    ~UMFlightRecorderLoggerPrivate();
+
+    void log(const UMEvent& event);
+
+    QString m_fileName;
+    UMBinaryFileHeader* m_header;
+    UMEvent* m_events;
+    size_t m_mappingSize;
+    quint64 m_index;
+    quint32 m_capacity;
+};
+
 #endif  // LOGGER_P_H
@@ -38,6 +38,17 @@ struct _UMLTTNGProcessEvent {
     uint32_t rssMemory;
     uint16_t cpuUsage;
     uint16_t threadCount;
+    uint32_t droppedEvents;
+    uint32_t pssMemory;
+    uint32_t ussMemory;
+    uint32_t minorFaults;
+    uint32_t majorFaults;
+    uint32_t voluntaryContextSwitches;
+    uint32_t involuntaryContextSwitches;
+    uint16_t guiThreadCpuUsage;
+    uint16_t renderThreadCpuUsage;
+    uint16_t loaderThreadCpuUsage;
+    uint16_t otherThreadCpuUsage;
 };
 
 struct _UMLTTNGFrameEvent {
@@ -36,6 +36,17 @@ TRACEPOINT_EVENT(
         ctf_integer(uint32_t, vsz_memory, processEvent->vszMemory)
         ctf_integer(uint32_t, rss_memory, processEvent->rssMemory)
         ctf_integer(uint16_t, thread_count, processEvent->threadCount)
+        ctf_integer(uint32_t, dropped_events, processEvent->droppedEvents)
+        ctf_integer(uint32_t, pss_memory, processEvent->pssMemory)
+        ctf_integer(uint32_t, uss_memory, processEvent->ussMemory)
+        ctf_integer(uint32_t, minor_faults, processEvent->minorFaults)
+        ctf_integer(uint32_t, major_faults, processEvent->majorFaults)
+        ctf_integer(uint32_t, voluntary_context_switches, processEvent->voluntaryContextSwitches)
+        ctf_integer(uint32_t, involuntary_context_switches, processEvent->involuntaryContextSwitches)
+        ctf_integer(uint16_t, gui_thread_cpu_usage, processEvent->guiThreadCpuUsage)
+        ctf_integer(uint16_t, render_thread_cpu_usage, processEvent->renderThreadCpuUsage)
+        ctf_integer(uint16_t, loader_thread_cpu_usage, processEvent->loaderThreadCpuUsage)
+        ctf_integer(uint16_t, other_thread_cpu_usage, processEvent->otherThreadCpuUsage)
     )
 )
 
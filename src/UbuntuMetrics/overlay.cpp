@@ -51,22 +51,44 @@ static const struct {
     quint16 defaultWidth;
     UMEvent::Type type;
 } metricInfo[] = {
-    { "cpuUsage",    sizeof("cpuUsage") - 1,    3, UMEvent::Process },
-    { "threadCount", sizeof("threadCount") - 1, 3, UMEvent::Process },
-    { "vszMemory",   sizeof("vszMemory") - 1,   8, UMEvent::Process },
-    { "rssMemory",   sizeof("rssMemory") - 1,   8, UMEvent::Process },
-    { "windowId",    sizeof("windowId") - 1,    2, UMEvent::Window  },
-    { "windowSize",  sizeof("windowSize") - 1,  9, UMEvent::Window  },
-    { "frameNumber", sizeof("frameNumber") - 1, 7, UMEvent::Frame   },
-    { "deltaTime",   sizeof("deltaTime") - 1,   7, UMEvent::Frame   },
-    { "syncTime",    sizeof("syncTime") - 1,    7, UMEvent::Frame   },
-    { "renderTime",  sizeof("renderTime") - 1,  7, UMEvent::Frame   },
-    { "gpuTime",     sizeof("gpuTime") - 1,     7, UMEvent::Frame   },
-    { "totalTime",   sizeof("totalTime") - 1,   7, UMEvent::Frame   }
+    { "cpuUsage",        sizeof("cpuUsage") - 1,        3, UMEvent::Process      },
+    { "threadCount",     sizeof("threadCount") - 1,     3, UMEvent::Process      },
+    { "vszMemory",       sizeof("vszMemory") - 1,       8, UMEvent::Process      },
+    { "rssMemory",       sizeof("rssMemory") - 1,       8, UMEvent::Process      },
+    { "droppedEvents",   sizeof("droppedEvents") - 1,   6, UMEvent::Process      },
+    { "pssMemory",       sizeof("pssMemory") - 1,       8, UMEvent::Process      },
+    { "ussMemory",       sizeof("ussMemory") - 1,       8, UMEvent::Process      },
+    { "minorFaults",     sizeof("minorFaults") - 1,     6, UMEvent::Process      },
+    { "majorFaults",     sizeof("majorFaults") - 1,     6, UMEvent::Process      },
+    { "contextSwitches", sizeof("contextSwitches") - 1, 6, UMEvent::Process      },
+    { "guiCpuUsage",     sizeof("guiCpuUsage") - 1,     3, UMEvent::Process      },
+    { "renderCpuUsage",  sizeof("renderCpuUsage") - 1,  3, UMEvent::Process      },
+    { "loaderCpuUsage",  sizeof("loaderCpuUsage") - 1,  3, UMEvent::Process      },
+    { "otherCpuUsage",   sizeof("otherCpuUsage") - 1,   3, UMEvent::Process      },
+    { "windowId",        sizeof("windowId") - 1,        2, UMEvent::Window       },
+    { "windowSize",      sizeof("windowSize") - 1,      9, UMEvent::Window       },
+    { "frameNumber",     sizeof("frameNumber") - 1,     7, UMEvent::Frame        },
+    { "deltaTime",       sizeof("deltaTime") - 1,       7, UMEvent::Frame        },
+    { "syncTime",        sizeof("syncTime") - 1,        7, UMEvent::Frame        },
+    { "renderTime",      sizeof("renderTime") - 1,      7, UMEvent::Frame        },
+    { "gpuTime",         sizeof("gpuTime") - 1,         7, UMEvent::Frame        },
+    { "totalTime",       sizeof("totalTime") - 1,       7, UMEvent::Frame        },
+    { "p50DeltaTime",    sizeof("p50DeltaTime") - 1,    7, UMEvent::FrameSummary },
+    { "p90DeltaTime",    sizeof("p90DeltaTime") - 1,    7, UMEvent::FrameSummary },
+    { "p99DeltaTime",    sizeof("p99DeltaTime") - 1,    7, UMEvent::FrameSummary },
+    { "maxDeltaTime",    sizeof("maxDeltaTime") - 1,    7, UMEvent::FrameSummary },
+    { "p99SyncTime",     sizeof("p99SyncTime") - 1,     7, UMEvent::FrameSummary },
+    { "p99RenderTime",   sizeof("p99RenderTime") - 1,   7, UMEvent::FrameSummary },
+    { "p99GpuTime",      sizeof("p99GpuTime") - 1,      7, UMEvent::FrameSummary },
+    { "p99SwapTime",     sizeof("p99SwapTime") - 1,     7, UMEvent::FrameSummary },
+    { "missedVsyncs",    sizeof("missedVsyncs") - 1,    5, UMEvent::FrameSummary }
 };
 enum {
-    CpuUsage = 0, ThreadCount, VszMemory, RssMemory, WindowId, WindowSize, FrameNumber, DeltaTime,
-    SyncTime, RenderTime, GpuTime, TotalTime, MetricCount
+    CpuUsage = 0, ThreadCount, VszMemory, RssMemory, DroppedEvents, PssMemory, UssMemory,
+    MinorFaults, MajorFaults, ContextSwitches, GuiCpuUsage, RenderCpuUsage, LoaderCpuUsage,
+    OtherCpuUsage, WindowId, WindowSize, FrameNumber, DeltaTime,
+    SyncTime, RenderTime, GpuTime, TotalTime, P50DeltaTime, P90DeltaTime, P99DeltaTime,
+    MaxDeltaTime, P99SyncTime, P99RenderTime, P99GpuTime, P99SwapTime, MissedVsyncs, MetricCount
 };
 Q_STATIC_ASSERT(ARRAY_SIZE(metricInfo) == MetricCount);
 
@@ -99,6 +121,8 @@ Overlay::Overlay(const char* text, int windowId)
     m_buffer = alignedAlloc(bufferAlignment, bufferSize);
     memset(&m_processEvent, 0, sizeof(m_processEvent));
     m_processEvent.type = UMEvent::Process;
+    memset(&m_frameSummaryEvent, 0, sizeof(m_frameSummaryEvent));
+    m_frameSummaryEvent.type = UMEvent::FrameSummary;
 }
 
 Overlay::~Overlay()
@@ -150,6 +174,14 @@ void Overlay::setProcessEvent(const UMEvent& processEvent)
     m_flags |= DirtyProcessEvent;
 }
 
+void Overlay::setFrameSummaryEvent(const UMEvent& frameSummaryEvent)
+{
+    DASSERT(frameSummaryEvent.type == UMEvent::FrameSummary);
+
+    memcpy(&m_frameSummaryEvent, &frameSummaryEvent, sizeof(m_frameSummaryEvent));
+    m_flags |= DirtyFrameSummaryEvent;
+}
+
 void Overlay::render(const UMEvent& frameEvent, const QSize& frameSize)
 {
     DASSERT(m_flags & Initialized);
@@ -170,6 +202,10 @@ void Overlay::render(const UMEvent& frameEvent, const QSize& frameSize)
         updateProcessMetrics();
         m_flags &= ~DirtyProcessEvent;
     }
+    if (m_flags & DirtyFrameSummaryEvent) {
+        updateFrameSummaryMetrics();
+        m_flags &= ~DirtyFrameSummaryEvent;
+    }
     updateFrameMetrics(frameEvent);
     m_bitmapText.render();
 }
@@ -343,6 +379,38 @@ void Overlay::updateProcessMetrics()
         case RssMemory:
             integerMetricToText(m_processEvent.process.rssMemory, text, textWidth);
             break;
+        case DroppedEvents:
+            integerMetricToText(m_processEvent.process.droppedEvents, text, textWidth);
+            break;
+        case PssMemory:
+            integerMetricToText(m_processEvent.process.pssMemory, text, textWidth);
+            break;
+        case UssMemory:
+            integerMetricToText(m_processEvent.process.ussMemory, text, textWidth);
+            break;
+        case MinorFaults:
+            integerMetricToText(m_processEvent.process.minorFaults, text, textWidth);
+            break;
+        case MajorFaults:
+            integerMetricToText(m_processEvent.process.majorFaults, text, textWidth);
+            break;
+        case ContextSwitches:
+            integerMetricToText(
+                m_processEvent.process.voluntaryContextSwitches
+                + m_processEvent.process.involuntaryContextSwitches, text, textWidth);
+            break;
+        case GuiCpuUsage:
+            integerMetricToText(m_processEvent.process.guiThreadCpuUsage, text, textWidth);
+            break;
+        case RenderCpuUsage:
+            integerMetricToText(m_processEvent.process.renderThreadCpuUsage, text, textWidth);
+            break;
+        case LoaderCpuUsage:
+            integerMetricToText(m_processEvent.process.loaderThreadCpuUsage, text, textWidth);
+            break;
+        case OtherCpuUsage:
+            integerMetricToText(m_processEvent.process.otherThreadCpuUsage, text, textWidth);
+            break;
         default:
             DNOT_REACHED();
             break;
@@ -354,6 +422,59 @@ void Overlay::updateProcessMetrics()
     }
 }
 
+void Overlay::updateFrameSummaryMetrics()
+{
+    DASSERT(m_flags & Initialized);
+    Q_STATIC_ASSERT(IS_POWER_OF_TWO(maxMetricWidth));
+
+    const UMFrameSummaryEvent& summary = m_frameSummaryEvent.frameSummary;
+    const quint32* deltaTimes = summary.times[UMFrameSummaryEvent::DeltaTime];
+    const int p99 = UMFrameSummaryEvent::P99;
+    char* text = static_cast<char*>(m_buffer);
+    for (int i = 0; i < m_metricsSize[UMEvent::FrameSummary]; i++) {
+        int textWidth = m_metrics[UMEvent::FrameSummary][i].width;
+        DASSERT(textWidth <= maxMetricWidth);
+        memset(text, ' ', maxMetricWidth);
+
+        switch (m_metrics[UMEvent::FrameSummary][i].index) {
+        case P50DeltaTime:
+            timeMetricToText(deltaTimes[UMFrameSummaryEvent::P50], text, textWidth);
+            break;
+        case P90DeltaTime:
+            timeMetricToText(deltaTimes[UMFrameSummaryEvent::P90], text, textWidth);
+            break;
+        case P99DeltaTime:
+            timeMetricToText(deltaTimes[UMFrameSummaryEvent::P99], text, textWidth);
+            break;
+        case MaxDeltaTime:
+            timeMetricToText(deltaTimes[UMFrameSummaryEvent::Max], text, textWidth);
+            break;
+        case P99SyncTime:
+            timeMetricToText(summary.times[UMFrameSummaryEvent::SyncTime][p99], text, textWidth);
+            break;
+        case P99RenderTime:
+            timeMetricToText(summary.times[UMFrameSummaryEvent::RenderTime][p99], text, textWidth);
+            break;
+        case P99GpuTime:
+            timeMetricToText(summary.times[UMFrameSummaryEvent::GpuTime][p99], text, textWidth);
+            break;
+        case P99SwapTime:
+            timeMetricToText(summary.times[UMFrameSummaryEvent::SwapTime][p99], text, textWidth);
+            break;
+        case MissedVsyncs:
+            integerMetricToText(summary.missedVsyncCount, text, textWidth);
+            break;
+        default:
+            DNOT_REACHED();
+            break;
+        }
+
+        m_bitmapText.updateText(
+            text, m_metrics[UMEvent::FrameSummary][i].textIndex,
+            m_metrics[UMEvent::FrameSummary][i].width);
+    }
+}
+
 static int cpuModel(char* buffer, int bufferSize)
 {
     DASSERT(buffer);
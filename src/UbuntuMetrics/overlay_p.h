@@ -45,6 +45,9 @@ public:
     // Sets the process event.
     void setProcessEvent(const UMEvent& processEvent);
 
+    // Sets the frame summary event.
+    void setFrameSummaryEvent(const UMEvent& frameSummaryEvent);
+
     // Renders the overlay. Must be called in a thread with the same OpenGL
     // context bound than at initialize().
     void render(const UMEvent& frameEvent, const QSize& frameSize);
@@ -53,13 +56,15 @@ private:
     void updateFrameMetrics(const UMEvent& frameEvent);
     void updateWindowMetrics(quint32 windowId, const QSize& frameSize);
     void updateProcessMetrics();
+    void updateFrameSummaryMetrics();
     int keywordString(int index, char* buffer, int bufferSize);
     void parseText();
 
     enum {
         Initialized       = (1 << 0),
         DirtyText         = (1 << 1),
-        DirtyProcessEvent = (1 << 2)
+        DirtyProcessEvent = (1 << 2),
+        DirtyFrameSummaryEvent = (1 << 3)
     };
 
     static const int maxMetricsPerType = 16;
@@ -81,6 +86,7 @@ private:
     quint32 m_windowId;
     quint8 m_flags;
     alignas(64) UMEvent m_processEvent;
+    alignas(64) UMEvent m_frameSummaryEvent;
 };
 
 #endif  // OVERLAY_P_H
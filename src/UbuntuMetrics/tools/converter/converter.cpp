@@ -0,0 +1,120 @@
+// Copyright © 2016 Canonical Ltd.
+//
+// This file is part of Ubuntu UI Toolkit.
+//
+// Ubuntu UI Toolkit is free software: you can redistribute it and/or modify it
+// under the terms of the GNU Lesser General Public License as published by the
+// Free Software Foundation; version 3.
+//
+// Ubuntu UI Toolkit is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+// for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Ubuntu UI Toolkit. If not, see <http://www.gnu.org/licenses/>.
+
+// Converts binary files written by UMBinaryFileLogger and UMFlightRecorderLogger
+// to the text format written by UMFileLogger. Events of flight recorder files
+// are dumped in chronological order.
+
+#include <cstdio>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+
+#include <UbuntuMetrics/events.h>
+#include <UbuntuMetrics/logger.h>
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    QCommandLineParser args;
+    QCommandLineOption _human("human", "Output the human readable format instead of the parsable "
+                              "one");
+    args.addOption(_human);
+    args.addPositionalArgument(
+        "input", "Binary file written by UMBinaryFileLogger or UMFlightRecorderLogger");
+    args.addPositionalArgument("output", "Text file, the standard output if not set",
+                               "[output]");
+    args.addHelpOption();
+    args.process(application);
+
+    const QStringList positionalArguments = args.positionalArguments();
+    if (positionalArguments.isEmpty()) {
+        args.showHelp(1);
+    }
+
+    QFile input(positionalArguments[0]);
+    if (!input.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "Can't open '%s' (%s).\n", qPrintable(input.fileName()),
+                qPrintable(input.errorString()));
+        return 1;
+    }
+
+    UMBinaryFileHeader header;
+    if (input.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+        || header.magic != UMBinaryFileHeader::magicNumber) {
+        fprintf(stderr, "'%s' is not a binary metrics file.\n", qPrintable(input.fileName()));
+        return 1;
+    }
+    if (header.version != UMBinaryFileHeader::currentVersion
+        || header.eventSize != sizeof(UMEvent)) {
+        fprintf(stderr, "Unsupported binary metrics file version %u.\n", header.version);
+        return 1;
+    }
+
+    const bool parsable = !args.isSet(_human);
+    UMFileLogger* logger = positionalArguments.size() > 1
+        ? new UMFileLogger(positionalArguments[1], parsable)
+        : new UMFileLogger(stdout, parsable);
+    if (!logger->isOpen()) {
+        delete logger;
+        return 1;
+    }
+
+    if (header.ringCapacity == 0) {
+        UMEvent event;
+        qint64 size;
+        while ((size = input.read(reinterpret_cast<char*>(&event), sizeof(event)))
+               == sizeof(event)) {
+            if (event.type >= UMEvent::TypeCount) {
+                fprintf(stderr, "Invalid event type %d, stopping.\n", event.type);
+                break;
+            }
+            logger->log(event);
+        }
+        if (size > 0) {
+            fprintf(stderr, "Truncated event at the end of the file.\n");
+        }
+    } else {
+        const quint64 capacity = header.ringCapacity;
+        const qint64 size = capacity * sizeof(UMEvent);
+        uchar* mapping = input.map(sizeof(header), size);
+        if (!mapping || (capacity & (capacity - 1))) {
+            fprintf(stderr, "Invalid flight recorder file.\n");
+            delete logger;
+            return 1;
+        }
+        const UMEvent* events = reinterpret_cast<const UMEvent*>(mapping);
+        if (header.ringIndex > 0) {
+            // Skip the records older than the duration covered by the file.
+            const quint64 first = header.ringIndex > capacity ? header.ringIndex - capacity : 0;
+            const quint64 lastTimeStamp = events[(header.ringIndex - 1) & (capacity - 1)].timeStamp;
+            const quint64 duration = static_cast<quint64>(header.ringDuration) * 1000000;
+            const quint64 minTimeStamp = lastTimeStamp > duration ? lastTimeStamp - duration : 0;
+            for (quint64 i = first; i < header.ringIndex; ++i) {
+                const UMEvent& event = events[i & (capacity - 1)];
+                if (event.type < UMEvent::TypeCount && event.timeStamp >= minTimeStamp) {
+                    logger->log(event);
+                }
+            }
+        }
+        input.unmap(mapping);
+    }
+
+    delete logger;
+    return 0;
+}
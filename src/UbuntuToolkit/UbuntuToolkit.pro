@@ -46,10 +46,12 @@ HEADERS += \
     $$PWD/mousetouchadaptor_p_p.h \
     $$PWD/privates/appheaderbase_p.h \
     $$PWD/privates/frame_p.h \
+    $$PWD/privates/indexranges_p.h \
     $$PWD/privates/listitemdragarea_p.h \
     $$PWD/privates/listitemdraghandler_p.h \
     $$PWD/privates/listitemselection_p.h \
     $$PWD/privates/listviewextensions_p.h \
+    $$PWD/privates/pickermodel_p.h \
     $$PWD/privates/splitviewhandler_p.h \
     $$PWD/privates/threelabelsslot_p.h \
     $$PWD/privates/ucpagewrapper_p.h \
@@ -158,11 +160,13 @@ SOURCES += \
     $$PWD/mousetouchadaptor.cpp \
     $$PWD/privates/appheaderbase.cpp \
     $$PWD/privates/frame.cpp \
+    $$PWD/privates/indexranges.cpp \
     $$PWD/privates/listitemdragarea.cpp \
     $$PWD/privates/listitemdraghandler.cpp \
     $$PWD/privates/listitemexpansion.cpp \
     $$PWD/privates/listitemselection.cpp \
     $$PWD/privates/listviewextensions.cpp \
+    $$PWD/privates/pickermodel.cpp \
     $$PWD/privates/splitviewhandler.cpp \
     $$PWD/privates/threelabelsslot_p.cpp \
     $$PWD/privates/ucpagewrapper.cpp \
@@ -20,6 +20,8 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSaveFile>
 #include <QtCore/QTimeZone>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QJsonDocument>
@@ -32,6 +34,9 @@
 #include "ucalarm_p_p.h"
 
 static const QString alarmDatabase = QStringLiteral("%1/alarms.json");
+static const QString alarmJournal = QStringLiteral("%1/alarms.journal");
+// the journal is compacted into the database once it has more records than this or than alarms
+static const int minimumJournalSize = 64;
 
 // The main alarm manager engine used from Saucy onwards is EDS (Evolution Data
 // Server) based. Any previous release uses the generic "memory" manager engine
@@ -376,6 +381,152 @@ void AlarmDataAdapter::setData(const QOrganizerTodo &data)
     }
 }
 
+/*-----------------------------------------------------------------------------
+ * Journaled storage of the fallback manager alarms.
+ */
+class AlarmStorageTask : public QRunnable
+{
+public:
+    // appends the data to the journal, or replaces the database with it and removes the journal
+    AlarmStorageTask(const QString &path, const QByteArray &data, bool compact)
+        : path(path), data(data), compact(compact)
+    {
+    }
+
+    void run() override
+    {
+        QDir dir(path);
+        if (!dir.exists()) {
+            dir.mkpath(path);
+        }
+        if (compact) {
+            QSaveFile database(alarmDatabase.arg(path));
+            if (!database.open(QFile::WriteOnly)) {
+                return;
+            }
+            database.write(data);
+            if (database.commit()) {
+                QFile::remove(alarmJournal.arg(path));
+            }
+        } else {
+            QFile journal(alarmJournal.arg(path));
+            if (!journal.open(QFile::WriteOnly | QFile::Append)) {
+                return;
+            }
+            journal.write(data);
+        }
+    }
+
+private:
+    QString path;
+    QByteArray data;
+    bool compact;
+};
+
+AlarmStorage::AlarmStorage(const QString &path)
+    : path(path)
+    , journalRecords(0)
+{
+    // a single thread keeps the writes in order
+    pool.setMaxThreadCount(1);
+}
+
+QList<QJsonObject> AlarmStorage::load()
+{
+    waitForDone();
+    QList<QJsonObject> alarms;
+    QHash<QString, int> indexes;
+    QFile database(alarmDatabase.arg(path));
+    if (database.open(QFile::ReadOnly)) {
+        const QJsonArray array = QJsonDocument::fromJson(database.readAll()).array();
+        for (int i = 0; i < array.size(); i++) {
+            const QJsonObject alarm = array[i].toObject();
+            indexes.insert(alarm[QStringLiteral("id")].toString(), alarms.size());
+            alarms.append(alarm);
+        }
+    }
+    // databases written before the journal was introduced have no ids
+    indexes.remove(QString());
+
+    journalRecords = 0;
+    QFile journal(alarmJournal.arg(path));
+    if (journal.open(QFile::ReadOnly)) {
+        while (!journal.atEnd()) {
+            QJsonParseError error;
+            QJsonObject record = QJsonDocument::fromJson(journal.readLine(), &error).object();
+            if (error.error != QJsonParseError::NoError) {
+                // a record that was not completely written
+                continue;
+            }
+            journalRecords++;
+            const QString id = record[QStringLiteral("id")].toString();
+            const QString operation = record.take(QStringLiteral("operation")).toString();
+            const int index = indexes.value(id, -1);
+            if (operation == QStringLiteral("remove")) {
+                if (index >= 0) {
+                    alarms[index] = QJsonObject();
+                    indexes.remove(id);
+                }
+            } else if (index >= 0) {
+                alarms[index] = record;
+            } else {
+                indexes.insert(id, alarms.size());
+                alarms.append(record);
+            }
+        }
+    }
+    alarms.removeAll(QJsonObject());
+    return alarms;
+}
+
+void AlarmStorage::reset(const QList<QJsonObject> &alarms)
+{
+    QJsonArray array;
+    Q_FOREACH(const QJsonObject &alarm, alarms) {
+        array.append(alarm);
+    }
+    pendingRecords.clear();
+    journalRecords = 0;
+    pool.start(new AlarmStorageTask(path, QJsonDocument(array).toJson(), true));
+}
+
+void AlarmStorage::save(const QJsonObject &alarm)
+{
+    QJsonObject record(alarm);
+    record[QStringLiteral("operation")] = QStringLiteral("save");
+    append(record);
+}
+
+void AlarmStorage::remove(const QString &id)
+{
+    QJsonObject record;
+    record[QStringLiteral("id")] = id;
+    record[QStringLiteral("operation")] = QStringLiteral("remove");
+    append(record);
+}
+
+void AlarmStorage::commit()
+{
+    if (pendingRecords.isEmpty()) {
+        return;
+    }
+    pool.start(new AlarmStorageTask(path, pendingRecords, false));
+    pendingRecords.clear();
+}
+
+void AlarmStorage::waitForDone()
+{
+    pool.waitForDone();
+}
+
+// one record per line, compact JSON has no line breaks
+void AlarmStorage::append(const QJsonObject &record)
+{
+    pendingRecords.append(QJsonDocument(record).toJson(QJsonDocument::Compact));
+    pendingRecords.append('\n');
+    journalRecords++;
+}
+
 /*-----------------------------------------------------------------------------
  * Adaptation layer for Alarms.
  */
@@ -388,6 +539,7 @@ AlarmsAdapter::AlarmsAdapter(AlarmManager *qq)
     : QObject(qq)
     , AlarmManagerPrivate(qq)
     , manager(0)
+    , storage(0)
 {
     // register QOrganizerItemId comparators so QVariant == operator can compare them
     QMetaType::registerComparators<QOrganizerItemId>();
@@ -440,12 +592,12 @@ void AlarmsAdapter::alarmOperation(QList<QPair<QOrganizerItemId,QOrganizerManage
         }
         case QOrganizerManager::Remove: {
             removeAlarm(op.first);
-            // save alarm data
             break;
         }
         }
     }
-    saveAlarms();
+    // save alarm data
+    saveAlarms(list);
 }
 
 void AlarmsAdapter::init()
@@ -462,6 +614,8 @@ void AlarmsAdapter::init()
 
 AlarmsAdapter::~AlarmsAdapter()
 {
+    // waits for the pending writes
+    delete storage;
 }
 
 UCAlarmPrivate * AlarmsAdapter::createAlarmData(UCAlarm *alarm)
@@ -469,22 +623,30 @@ UCAlarmPrivate * AlarmsAdapter::createAlarmData(UCAlarm *alarm)
     return new AlarmDataAdapter(alarm);
 }
 
+static QJsonObject alarmToJson(const UCAlarm *alarm)
+{
+    QJsonObject object;
+    object[QStringLiteral("id")] = alarm->cookie().value<QOrganizerItemId>().toString();
+    object[QStringLiteral("message")] = alarm->message();
+    object[QStringLiteral("date")] = alarm->date().toString();
+    object[QStringLiteral("sound")] = alarm->sound().toString();
+    object[QStringLiteral("type")] = QJsonValue(alarm->type());
+    object[QStringLiteral("days")] = QJsonValue((int)alarm->daysOfWeek());
+    object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
+    return object;
+}
+
 // load fallback manager data
 void AlarmsAdapter::loadAlarms()
 {
     if (manager->managerName() != alarmManagerFallback) {
         return;
     }
-    QFile file(alarmDatabase.arg(QStandardPaths::writableLocation(QStandardPaths::DataLocation)));
-    if (!file.open(QFile::ReadOnly)) {
-        return;
-    }
-    QByteArray data = file.readAll();
-    QJsonDocument document(QJsonDocument::fromJson(data));
-    QJsonArray array = document.array();
-    for (int i = 0; i < array.size(); i++) {
-        QJsonObject object = array[i].toObject();
+    storage = new AlarmStorage(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+    QList<QJsonObject> objects = storage->load();
 
+    QList<QOrganizerItem> events;
+    Q_FOREACH(const QJsonObject &object, objects) {
         // use UCAlarm to save store JSON data
         UCAlarm alarm;
         alarm.setMessage(object[QStringLiteral("message")].toString());
@@ -498,43 +660,47 @@ void AlarmsAdapter::loadAlarms()
         AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
         // call checkAlarm to complete field checks (i.e. type vs daysOfWeek, kick date, etc)
         pAlarm->checkAlarm();
-        QOrganizerTodo event = pAlarm->data();
-        manager->saveItem(&event);
+        events << pAlarm->data();
+    }
+    manager->saveItems(&events);
+
+    // the alarms get new ids, rewrite the database with them so the journal can refer to them;
+    // this also drops any record left incomplete at the end of the journal
+    for (int i = 0; i < objects.count(); i++) {
+        objects[i][QStringLiteral("id")] = events[i].id().toString();
     }
-    file.close();
+    storage->reset(objects);
 }
 
 // save fallback manager data only
-void AlarmsAdapter::saveAlarms()
+void AlarmsAdapter::saveAlarms(const QList<QPair<QOrganizerItemId,QOrganizerManager::Operation> > &operations)
 {
-    if (manager->managerName() != alarmManagerFallback) {
+    if (!storage) {
         return;
     }
-    QDir dir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
-    if (!dir.exists()) {
-        dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
-    }
-    QFile file(alarmDatabase.arg(dir.path()));
-    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+    if (storage->journalSize() + operations.count() > qMax(minimumJournalSize, alarmList.count())) {
+        // compact the journal into the database
+        QList<QJsonObject> objects;
+        for (int i = 0; i < alarmList.count(); i++) {
+            objects << alarmToJson(alarmList[i]);
+        }
+        storage->reset(objects);
         return;
     }
-    QJsonArray data;
-    for(int i = 0; i < alarmList.count(); i++) {
-        // create an UCAlarm and set its event to ease conversions
-        const UCAlarm *alarm = alarmList[i];
-        QJsonObject object;
-        object[QStringLiteral("message")] = alarm->message();
-        object[QStringLiteral("date")] = alarm->date().toString();
-        object[QStringLiteral("sound")] = alarm->sound().toString();
-        object[QStringLiteral("type")] = QJsonValue(alarm->type());
-        object[QStringLiteral("days")] = QJsonValue((int)alarm->daysOfWeek());
-        object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
-        data.append(object);
 
+    typedef QPair<QOrganizerItemId,QOrganizerManager::Operation> OperationPair;
+    Q_FOREACH(const OperationPair &op, operations) {
+        if (op.second == QOrganizerManager::Remove) {
+            storage->remove(op.first.toString());
+            continue;
+        }
+        // the operation may be reported on an occurrence of the alarm
+        int index = alarmList.indexOf(todoItem(op.first).id());
+        if (index >= 0) {
+            storage->save(alarmToJson(alarmList[index]));
+        }
     }
-    QJsonDocument document(data);
-    file.write(document.toJson());
-    file.close();
+    storage->commit();
 }
 
 /*-----------------------------------------------------------------------------
@@ -643,7 +809,6 @@ bool AlarmsAdapter::fetchAlarms()
                          this, &AlarmsAdapter::completeFetchAlarms);
     }
 
-    Q_EMIT q_ptr->alarmsRefreshStarted();
     return fetchRequest->start();
 }
 
@@ -728,6 +893,12 @@ void AlarmsAdapter::updateAlarm(const QOrganizerItemId &id)
     AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
     pAlarm->setData(event);
     adjustAlarmOccurrence(*pAlarm);
+    updateAlarmAt(index, alarm);
+}
+
+// updates the alarm at index and reports the update or the move caused by a date change
+void AlarmsAdapter::updateAlarmAt(int index, const UCAlarm &alarm)
+{
     int newIndex = alarmList.update(index, alarm);
     if (newIndex == index) {
         Q_EMIT q_ptr->alarmUpdated(index);
@@ -755,38 +926,78 @@ void AlarmsAdapter::removeAlarm(const QOrganizerItemId &id)
     Q_EMIT q_ptr->alarmRemoveFinished();
 }
 
+static bool sameAlarmData(const UCAlarm &alarm, const UCAlarm &other)
+{
+    return alarm == other
+        && alarm.enabled() == other.enabled()
+        && alarm.sound() == other.sound();
+}
+
 void AlarmsAdapter::completeFetchAlarms()
 {
     if (fetchRequest->state() != QOrganizerAbstractRequest::FinishedState) {
         return;
     }
-    alarmList.clear();
 
-    QSet<QOrganizerItemId> parentId;
+    QSet<QOrganizerItemId> eventIds;
+    QList<UCAlarm*> alarms;
     QOrganizerTodo event;
     Q_FOREACH(const QOrganizerItem &item, fetchRequest->items()) {
         // repeating alarms may be fetched as occurences, therefore check their parent event
         if (item.type() == QOrganizerItemType::TypeTodoOccurrence) {
             QOrganizerTodoOccurrence occurrence = static_cast<QOrganizerTodoOccurrence>(item);
             QOrganizerItemId eventId = occurrence.parentId();
-            if (parentId.contains(eventId)) {
+            if (eventIds.contains(eventId)) {
                 continue;
             }
-            parentId << eventId;
             event = static_cast<QOrganizerTodo>(manager->item(eventId));
         } else if (item.type() == QOrganizerItemType::TypeTodo){
+            if (eventIds.contains(item.id())) {
+                continue;
+            }
             event = static_cast<QOrganizerTodo>(item);
         } else {
             continue;
         }
+        eventIds << event.id();
 
         // use UCAlarm to ease conversions
-        UCAlarm alarm;
-        AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
+        UCAlarm *alarm = new UCAlarm;
+        AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(alarm));
         pAlarm->setData(event);
         adjustAlarmOccurrence(*pAlarm);
-        alarmList.insert(alarm);
+        alarms << alarm;
+    }
+
+    if (!alarmList.count()) {
+        // nothing to keep, reset the list
+        Q_EMIT q_ptr->alarmsRefreshStarted();
+        Q_FOREACH(const UCAlarm *alarm, alarms) {
+            alarmList.insert(*alarm);
+        }
+    } else {
+        // apply the differences so the views keep the rows which did not change;
+        // remove the alarms which are gone, starting from the end to keep the indexes valid
+        for (int i = alarmList.count() - 1; i >= 0; i--) {
+            if (!eventIds.contains(alarmList[i]->cookie().value<QOrganizerItemId>())) {
+                Q_EMIT q_ptr->alarmRemoveStarted(i);
+                alarmList.removeAt(i);
+                Q_EMIT q_ptr->alarmRemoveFinished();
+            }
+        }
+        // then update the changed alarms and insert the new ones
+        Q_FOREACH(const UCAlarm *alarm, alarms) {
+            int index = alarmList.indexOf(alarm->cookie().value<QOrganizerItemId>());
+            if (index < 0) {
+                index = alarmList.insert(*alarm);
+                Q_EMIT q_ptr->alarmInsertStarted(index);
+                Q_EMIT q_ptr->alarmInsertFinished();
+            } else if (!sameAlarmData(*alarmList[index], *alarm)) {
+                updateAlarmAt(index, *alarm);
+            }
+        }
     }
+    qDeleteAll(alarms);
 
     completed = true;
     Q_EMIT q_ptr->alarmsRefreshed();
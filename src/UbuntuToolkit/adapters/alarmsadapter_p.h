@@ -19,6 +19,8 @@
 #ifndef ALARMSADAPTER_P_H
 #define ALARMSADAPTER_P_H
 
+#include <QtCore/QJsonObject>
+#include <QtCore/QThreadPool>
 #include <QtOrganizer/QOrganizerManager>
 #include <QtOrganizer/QOrganizerAbstractRequest>
 #include <QtOrganizer/QOrganizerItemFetchRequest>
@@ -163,6 +165,37 @@ private:
     QHash<QOrganizerItemId, QDateTime> idHash;
 };
 
+// Storage of the fallback manager alarms: a database holding all the alarms and a journal of
+// the changes made since the database was written. Writes happen in order on a worker thread.
+class UBUNTUTOOLKIT_EXPORT AlarmStorage
+{
+public:
+    AlarmStorage(const QString &path);
+
+    // returns the alarms of the database with the journal replayed on them
+    QList<QJsonObject> load();
+    // replaces the database with the given alarms and empties the journal
+    void reset(const QList<QJsonObject> &alarms);
+    // journal the saving or removal of an alarm, written by commit()
+    void save(const QJsonObject &alarm);
+    void remove(const QString &id);
+    void commit();
+    void waitForDone();
+
+    int journalSize() const
+    {
+        return journalRecords;
+    }
+
+private:
+    void append(const QJsonObject &record);
+
+    QString path;
+    QByteArray pendingRecords;
+    int journalRecords;
+    QThreadPool pool;
+};
+
 class AlarmsAdapter : public QObject, public AlarmManagerPrivate
 {
     Q_OBJECT
@@ -191,7 +224,7 @@ public:
     void adjustAlarmOccurrence(AlarmDataAdapter &alarm);
 
     void loadAlarms();
-    void saveAlarms();
+    void saveAlarms(const QList<QPair<QOrganizerItemId,QOrganizerManager::Operation> > &operations);
 
     bool verifyChange(UCAlarm *alarm, AlarmManager::Change change, const QVariant &value) override;
     UCAlarmPrivate *createAlarmData(UCAlarm *alarm) override;
@@ -199,6 +232,7 @@ public:
     void insertAlarm(const QOrganizerItemId &id);
     void updateAlarm(const QOrganizerItemId &id);
     void removeAlarm(const QOrganizerItemId &id);
+    void updateAlarmAt(int index, const UCAlarm &alarm);
 
 private Q_SLOTS:
     void completeFetchAlarms();
@@ -208,6 +242,7 @@ private Q_SLOTS:
 protected:
     QPointer<QOrganizerItemFetchRequest> fetchRequest;
     AlarmList alarmList;
+    AlarmStorage *storage;
     QOrganizerTodo todoItem(const QOrganizerItemId &id);
 };
 
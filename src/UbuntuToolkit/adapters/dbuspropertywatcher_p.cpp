@@ -19,7 +19,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <QtDBus/QDBusReply>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusPendingReply>
+#include <QtDBus/QDBusVariant>
 #include <QtQml/QQmlInfo>
 
 #include "i18n_p.h"
@@ -38,7 +42,8 @@ DBusServiceProperties::DBusServiceProperties(UCServiceProperties *qq)
     : UCServicePropertiesPrivate(qq)
     , connection(QStringLiteral(""))
     , watcher(0)
-    , iface(0)
+    , setupCall(0)
+    , fetchCall(0)
 {
 }
 
@@ -46,10 +51,18 @@ bool DBusServiceProperties::init()
 {
     // crear previous connections
     setStatus(UCServiceProperties::Inactive);
-    delete iface;
-    iface = 0;
+    delete setupCall;
+    setupCall = 0;
+    delete fetchCall;
+    fetchCall = 0;
     delete watcher;
     watcher = 0;
+    if (!objectPath.isEmpty()) {
+        connection.disconnect(service, objectPath, dbusInterface,
+                              QStringLiteral("PropertiesChanged"),
+                              this, SLOT(updateProperties(QString,QVariantMap,QStringList)));
+        objectPath.clear();
+    }
     setError(QString());
 
     if (service.isEmpty() || path.isEmpty()) {
@@ -80,13 +93,6 @@ bool DBusServiceProperties::init()
     Q_Q(UCServiceProperties);
     // connect dbus watcher to catch OwnerChanged
     watcher = new QDBusServiceWatcher(service, connection, QDBusServiceWatcher::WatchForOwnerChange, q);
-    // connect interface
-    iface = new QDBusInterface(service, path, interface, connection, q);
-    if (!iface->isValid()) {
-        setStatus(UCServiceProperties::ConnectionError);
-        setError(iface->lastError().message());
-        return false;
-    }
     // connect watcher to get owner changes
     QObject::connect(watcher, SIGNAL(serviceOwnerChanged(QString,QString,QString)),
                      this, SLOT(changeServiceOwner(QString,QString,QString)));
@@ -94,39 +100,115 @@ bool DBusServiceProperties::init()
 }
 
 /*
- * Connect dbus signal identified by (service, path, iface, name) quaduple to a
- * slot to receive property changes.
+ * Resolves the object path of the user asynchronously. The property values are fetched and
+ * the status set to Active once the service replied, see setupFinished(). Nothing on the
+ * service side is introspected, so none of this blocks the GUI thread.
  */
 bool DBusServiceProperties::setupInterface()
 {
-    QDBusReply<QDBusObjectPath> dbusObjectPath =
-        iface->call(QStringLiteral("FindUserById"), qlonglong(getuid()));
-    if (dbusObjectPath.isValid()) {
-        objectPath = dbusObjectPath.value().path();
-        iface->connection().connect(
-            service,
-            objectPath,
-            dbusInterface,
-            QStringLiteral("PropertiesChanged"),
-            this,
-            SLOT(updateProperties(QString,QVariantMap,QStringList)));
-        return true;
+    Q_Q(UCServiceProperties);
+    delete setupCall;
+    QDBusMessage message =
+        QDBusMessage::createMethodCall(service, path, interface, QStringLiteral("FindUserById"));
+    message << qlonglong(getuid());
+    setupCall = new QDBusPendingCallWatcher(connection.asyncCall(message), q);
+    QObject::connect(setupCall, SIGNAL(finished(QDBusPendingCallWatcher*)),
+                     this, SLOT(setupFinished(QDBusPendingCallWatcher*)));
+    setStatus(UCServiceProperties::Synchronizing);
+    return true;
+}
+
+/*
+ * Slot called when the object path is resolved. Connects the dbus signal identified by
+ * (service, path, iface, name) quaduple to a slot to receive property changes, and fetches
+ * the property values.
+ */
+void DBusServiceProperties::setupFinished(QDBusPendingCallWatcher *call)
+{
+    setupCall = 0;
+    call->deleteLater();
+    QDBusPendingReply<QDBusObjectPath> reply = *call;
+    if (reply.isError()) {
+        setStatus(UCServiceProperties::ConnectionError);
+        setError(reply.error().message());
+        return;
     }
 
-    setStatus(UCServiceProperties::ConnectionError);
-    setError(dbusObjectPath.error().message());
-    return false;
+    if (!objectPath.isEmpty()) {
+        connection.disconnect(service, objectPath, dbusInterface,
+                              QStringLiteral("PropertiesChanged"),
+                              this, SLOT(updateProperties(QString,QVariantMap,QStringList)));
+    }
+    objectPath = reply.value().path();
+    connection.connect(
+        service,
+        objectPath,
+        dbusInterface,
+        QStringLiteral("PropertiesChanged"),
+        this,
+        SLOT(updateProperties(QString,QVariantMap,QStringList)));
+    fetchPropertyValues();
 }
 
+/*
+ * Fetches all the property values of the adaptor interface in a single call. If the object
+ * path is not yet known, the values are fetched once it gets resolved.
+ */
 bool DBusServiceProperties::fetchPropertyValues()
 {
     scannedProperties = properties;
-    Q_FOREACH(QString property, properties) {
-        readProperty(property);
+    if (objectPath.isEmpty()) {
+        return true;
     }
+    Q_Q(UCServiceProperties);
+    delete fetchCall;
+    QDBusMessage message =
+        QDBusMessage::createMethodCall(service, objectPath, dbusInterface, QStringLiteral("GetAll"));
+    message << adaptor;
+    fetchCall = new QDBusPendingCallWatcher(connection.asyncCall(message), q);
+    QObject::connect(fetchCall, SIGNAL(finished(QDBusPendingCallWatcher*)),
+                     this, SLOT(fetchFinished(QDBusPendingCallWatcher*)));
     return true;
 }
 
+/*
+ * Slot called when the property values are fetched.
+ */
+void DBusServiceProperties::fetchFinished(QDBusPendingCallWatcher *call)
+{
+    fetchCall = 0;
+    call->deleteLater();
+    QDBusPendingReply<QVariantMap> reply = *call;
+    if (reply.isError()) {
+        // the service may only allow reading the properties one by one
+        Q_FOREACH(const QString &property, scannedProperties) {
+            readProperty(property);
+        }
+        return;
+    }
+
+    const QVariantMap values = reply.value();
+    Q_FOREACH(const QString &property, scannedProperties) {
+        QVariantMap::const_iterator value = values.constFind(property);
+        if (value != values.constEnd()) {
+            assignProperty(property, value.value());
+        } else {
+            // remove the property from being watched, as it has no property like that
+            properties.removeAll(property);
+            if (property[0].isUpper()) {
+                // report error!
+                warning(QStringLiteral("No such property '%1'").arg(property));
+            }
+        }
+    }
+    scannedProperties.clear();
+
+    if (status == UCServiceProperties::Synchronizing) {
+        // set status to active
+        setStatus(UCServiceProperties::Active);
+    }
+}
+
 /*
  * Reads a property value from the adaptorInterface asynchronously.
  */
@@ -136,15 +218,10 @@ bool DBusServiceProperties::readProperty(const QString &property)
         return false;
     }
     Q_Q(UCServiceProperties);
-    QDBusInterface readIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!readIFace.isValid()) {
-        // report invalid interface only if the property's first letter was with capital one!
-        if (property[0].isUpper()) {
-            warning(readIFace.lastError().message());
-        }
-        return false;
-    }
-    QDBusPendingCall pending = readIFace.asyncCall(QStringLiteral("Get"), adaptor, property);
+    QDBusMessage message =
+        QDBusMessage::createMethodCall(service, objectPath, dbusInterface, QStringLiteral("Get"));
+    message << adaptor << property;
+    QDBusPendingCall pending = connection.asyncCall(message);
     if (pending.isError()) {
         warning(pending.error().message());
         return false;
@@ -166,22 +243,28 @@ bool DBusServiceProperties::testProperty(const QString &property, const QVariant
     if (objectPath.isEmpty()) {
         return false;
     }
-    QDBusInterface writeIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!writeIFace.isValid()) {
-        // invalid interface
-        return false;
-    }
-    QDBusMessage msg = writeIFace.call(
-        QStringLiteral("Set"), adaptor, property, QVariant::fromValue(QDBusVariant(value)));
+    QDBusMessage message =
+        QDBusMessage::createMethodCall(service, objectPath, dbusInterface, QStringLiteral("Set"));
+    message << adaptor << property << QVariant::fromValue(QDBusVariant(value));
+    QDBusMessage msg = connection.call(message);
     return msg.type() == QDBusMessage::ReplyMessage;
 }
 
+/*
+ * Updates the watched property, making sure the first letter is lower case.
+ */
+void DBusServiceProperties::assignProperty(QString property, const QVariant &value)
+{
+    Q_Q(UCServiceProperties);
+    property[0] = property[0].toLower();
+    q->setProperty(property.toLocal8Bit().constData(), value);
+}
+
 /*
  * Slot called when the async read operation finishes.
  */
 void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
 {
-    Q_Q(UCServiceProperties);
     QDBusPendingReply<QVariant> reply = *call;
     QString property = call->property(dynamicProperty).toString();
     scannedProperties.removeAll(property);
@@ -194,9 +277,7 @@ void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
         }
     } else {
         // update watched property value
-        // make sure we have lower case when the property value is updated
-        property[0] = property[0].toLower();
-        q->setProperty(property.toLocal8Bit().constData(), reply.value());
+        assignProperty(property, reply.value());
     }
 
     if ((status == UCServiceProperties::Synchronizing) && scannedProperties.isEmpty()) {
@@ -226,8 +307,16 @@ void DBusServiceProperties::changeServiceOwner(const QString &serviceName, const
  */
 void DBusServiceProperties::updateProperties(const QString &onInterface, const QVariantMap &map, const QStringList &invalidated)
 {
-    Q_UNUSED(onInterface);
-    Q_UNUSED(map);
+    // changed values come with the signal, no need to read them back
+    if (adaptor.isEmpty() || onInterface == adaptor) {
+        QMapIterator<QString, QVariant> i(map);
+        while (i.hasNext()) {
+            i.next();
+            if (properties.contains(i.key())) {
+                assignProperty(i.key(), i.value());
+            }
+        }
+    }
     Q_FOREACH(const QString &property, invalidated) {
         readProperty(property);
     }
@@ -20,7 +20,6 @@
 #include <QtCore/QObject>
 #include <QtDBus/QDBusConnection>
 #include <QtDBus/QDBusServiceWatcher>
-#include <QtDBus/QDBusInterface>
 
 #include <UbuntuToolkit/private/ucserviceproperties_p_p.h>
 
@@ -44,12 +43,17 @@ public:
     QStringList scannedProperties;
     QDBusConnection connection;
     QDBusServiceWatcher *watcher;
-    QDBusInterface *iface;
+    // pending calls resolving the object path and fetching all the property values
+    QDBusPendingCallWatcher *setupCall;
+    QDBusPendingCallWatcher *fetchCall;
     QString objectPath;
 
     bool setupInterface();
+    void assignProperty(QString property, const QVariant &value);
 
 public Q_SLOTS:
+    void setupFinished(QDBusPendingCallWatcher *call);
+    void fetchFinished(QDBusPendingCallWatcher *call);
     void readFinished(QDBusPendingCallWatcher *watcher);
     void changeServiceOwner(const QString &serviceName, const QString &oldOwner, const QString &newOwner);
     void updateProperties(const QString &iface, const QVariantMap &map, const QStringList &invalidated);
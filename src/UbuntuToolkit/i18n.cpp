@@ -57,7 +57,23 @@ UT_NAMESPACE_BEGIN
  */
 UbuntuI18n *UbuntuI18n::m_i18 = nullptr;
 
-UbuntuI18n::UbuntuI18n(QObject* parent) : QObject(parent)
+// the cache is dropped when getting over this size, i.e. with plural texts of many counts
+static const int maximumCachedTranslations = 4096;
+
+uint qHash(const UbuntuI18n::TranslationKey &key, uint seed)
+{
+    seed = qHash(key.text, seed);
+    seed = qHash(key.context, seed);
+    seed = qHash(key.domain, seed);
+    seed = qHash(key.plural, seed);
+    return qHash(key.n, seed);
+}
+
+UbuntuI18n::UbuntuI18n(QObject* parent)
+    : QObject(parent)
+    , m_relativeDateFormatter(this)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
 {
     /*
      * setlocale
@@ -105,6 +121,8 @@ QString UbuntuI18n::language() const {
  */
 void UbuntuI18n::bindtextdomain(const QString& domain_name, const QString& dir_name) {
     C::bindtextdomain(domain_name.toUtf8(), dir_name.toUtf8());
+    m_relativeDateFormatter.invalidate();
+    flushTranslations();
     Q_EMIT domainChanged();
 }
 
@@ -125,6 +143,8 @@ void UbuntuI18n::setDomain(const QString &domain) {
     }
     QString localePath(QDir(appDir).filePath(QStringLiteral("share/locale")));
     C::bindtextdomain(domain.toUtf8(), localePath.toUtf8());
+    m_relativeDateFormatter.invalidate();
+    flushTranslations();
     Q_EMIT domainChanged();
 }
 
@@ -153,16 +173,55 @@ void UbuntuI18n::setLanguage(const QString &lang) {
      a valid locale string updates all category type defaults.
      */
     setlocale(LC_ALL, lang.toUtf8());
+    m_relativeDateFormatter.invalidate();
+    flushTranslations();
     Q_EMIT languageChanged();
 }
 
+UbuntuI18n::CacheStatistics UbuntuI18n::cacheStatistics() const
+{
+    CacheStatistics statistics = { m_cacheHits, m_cacheMisses, m_translations.count() };
+    return statistics;
+}
+
+bool UbuntuI18n::findTranslation(const TranslationKey &key, QString *translation)
+{
+    QHash<TranslationKey, QString>::const_iterator it = m_translations.constFind(key);
+    if (it == m_translations.constEnd()) {
+        m_cacheMisses++;
+        return false;
+    }
+    m_cacheHits++;
+    *translation = it.value();
+    return true;
+}
+
+QString UbuntuI18n::cacheTranslation(const TranslationKey &key, const QString &translation)
+{
+    if (m_translations.count() >= maximumCachedTranslations) {
+        m_translations.clear();
+    }
+    m_translations.insert(key, translation);
+    return translation;
+}
+
+void UbuntuI18n::flushTranslations()
+{
+    m_translations.clear();
+}
+
 /*!
  * \qmlmethod string i18n::tr(string text)
  * Translate \a text using gettext and return the translation.
  */
 QString UbuntuI18n::tr(const QString& text)
 {
-    return QString::fromUtf8(C::gettext(text.toUtf8()));
+    const TranslationKey key = { QString(), QString(), text, QString(), 0 };
+    QString translation;
+    if (!findTranslation(key, &translation)) {
+        translation = cacheTranslation(key, QString::fromUtf8(C::gettext(text.toUtf8())));
+    }
+    return translation;
 }
 
 /*!
@@ -175,7 +234,13 @@ QString UbuntuI18n::tr(const QString& text)
  */
 QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
 {
-    return QString::fromUtf8(C::ngettext(singular.toUtf8(), plural.toUtf8(), n));
+    const TranslationKey key = { QString(), QString(), singular, plural, n };
+    QString translation;
+    if (!findTranslation(key, &translation)) {
+        translation = cacheTranslation(key,
+            QString::fromUtf8(C::ngettext(singular.toUtf8(), plural.toUtf8(), n)));
+    }
+    return translation;
 }
 
 /*!
@@ -184,11 +249,17 @@ QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& text)
 {
+    const TranslationKey key = { domain, QString(), text, QString(), 0 };
+    QString translation;
+    if (findTranslation(key, &translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::dgettext(NULL, text.toUtf8()));
+        translation = QString::fromUtf8(C::dgettext(NULL, text.toUtf8()));
     } else {
-        return QString::fromUtf8(C::dgettext(domain.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::dgettext(domain.toUtf8(), text.toUtf8()));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -200,11 +271,17 @@ QString UbuntuI18n::dtr(const QString& domain, const QString& text)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& singular, const QString& plural, int n)
 {
+    const TranslationKey key = { domain, QString(), singular, plural, n };
+    QString translation;
+    if (findTranslation(key, &translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::dngettext(NULL, singular.toUtf8(), plural.toUtf8(), n));
+        translation = QString::fromUtf8(C::dngettext(NULL, singular.toUtf8(), plural.toUtf8(), n));
     } else {
-        return QString::fromUtf8(C::dngettext(domain.toUtf8(), singular.toUtf8(), plural.toUtf8(), n));
+        translation = QString::fromUtf8(C::dngettext(domain.toUtf8(), singular.toUtf8(), plural.toUtf8(), n));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -224,11 +301,19 @@ QString UbuntuI18n::ctr(const QString& context, const QString& text)
  */
 QString UbuntuI18n::dctr(const QString& domain, const QString& context, const QString& text)
 {
+    // a null context would match the plain lookups
+    const TranslationKey key = { domain, context.isNull() ? QStringLiteral("") : context, text,
+                                 QString(), 0 };
+    QString translation;
+    if (findTranslation(key, &translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::g_dpgettext2(NULL, context.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::g_dpgettext2(NULL, context.toUtf8(), text.toUtf8()));
     } else {
-        return QString::fromUtf8(C::g_dpgettext2(domain.toUtf8(), context.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::g_dpgettext2(domain.toUtf8(), context.toUtf8(), text.toUtf8()));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -274,90 +359,139 @@ QString UbuntuI18n::tag(const QString& context, const QString& text)
  * Translate a datetime based on proximity to current time.
  */
 QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
+{
+    return m_relativeDateFormatter.format(datetime, QDateTime::currentDateTime());
+}
+
+RelativeDateFormatter::RelativeDateFormatter(UbuntuI18n *i18n)
+    : m_i18n(i18n)
+    , m_loaded(false)
+{
+}
+
+void RelativeDateFormatter::invalidate()
+{
+    m_loaded = false;
+    m_minutes.clear();
+}
+
+// looks up the translated patterns, the 12h/24h variant being picked from the system locale
+void RelativeDateFormatter::load()
 {
     static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
+    const bool is12h = isLocale12h();
+
+    /* TRANSLATORS: Time based "this is happening/happened now" */
+    m_now = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("Now"));
+
+    /* en_US example: "1:00 PM" */
+    m_patterns[Today] = is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("HH:mm"));
+
+    /* en_US example: "Yesterday  13:00" */
+    m_patterns[Yesterday] = is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm"));
+
+    /* en_US example: "Tomorrow  1:00 PM" */
+    m_patterns[Tomorrow] = is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm"));
+
+    /* en_US example: "Fri  1:00 PM" */
+    m_patterns[Week] = is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm"));
+
+    m_patterns[FarAway] = is12h
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        ? m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
+        /* TRANSLATORS: Please translate these to your locale datetime
+           format using the format specified by
+           https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
+        : m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm"));
+
+    m_loaded = true;
+}
 
-    QDateTime relativeTo(QDateTime::currentDateTime());
-    const date_proximity_t prox = getDateProximity(relativeTo, datetime);
+// the plural forms depend on the count, so the texts are kept per distance in minutes
+QString RelativeDateFormatter::minutes(qint64 minutes)
+{
+    static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
 
-    switch (prox)  {
+    QHash<qint64, QString>::const_iterator it = m_minutes.constFind(minutes);
+    if (it != m_minutes.constEnd()) {
+        return it.value();
+    }
+    QString text;
+    if (minutes < 0) {
+        text = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
+                           QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
+    } else {
+        text = m_i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
+                           QStringLiteral("%1 minutes"), minutes).arg(minutes);
+    }
+    m_minutes.insert(minutes, text);
+    return text;
+}
+
+QString RelativeDateFormatter::format(const QDateTime &datetime, const QDateTime &relativeTo)
+{
+    if (!m_loaded) {
+        load();
+    }
+
+    switch (getDateProximity(relativeTo, datetime)) {
         case DATE_PROXIMITY_NOW:
-            /* TRANSLATORS: Time based "this is happening/happened now" */
-            return dtr(ubuntuUiToolkit, QStringLiteral("Now"));
+            return m_now;
 
         case DATE_PROXIMITY_HOUR:
-        {
-            qint64 diff = datetime.toMSecsSinceEpoch() - relativeTo.toMSecsSinceEpoch();
-            qint64 minutes = qRound(float(diff) / 60000);
-            if (minutes < 0) {
-                return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
-                           QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
-            }
-            return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
-                       QStringLiteral("%1 minutes"), minutes).arg(minutes);
-        }
+            return minutes(getProximityMinutes(relativeTo, datetime));
 
         case DATE_PROXIMITY_TODAY:
-            /* en_US example: "1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("HH:mm")));
+            return datetime.toString(m_patterns[Today]);
 
         case DATE_PROXIMITY_YESTERDAY:
-            /* en_US example: "Yesterday  13:00" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm")));
+            return datetime.toString(m_patterns[Yesterday]);
 
         case DATE_PROXIMITY_TOMORROW:
-            /* en_US example: "Tomorrow  1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm")));
+            return datetime.toString(m_patterns[Tomorrow]);
 
         case DATE_PROXIMITY_LAST_WEEK:
         case DATE_PROXIMITY_NEXT_WEEK:
-            /* en_US example: "Fri  1:00 PM" */
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm")));
+            return datetime.toString(m_patterns[Week]);
 
         case DATE_PROXIMITY_FAR_BACK:
         case DATE_PROXIMITY_FAR_FORWARD:
         default:
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
-            /* TRANSLATORS: Please translate these to your locale datetime
-               format using the format specified by
-               https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm")));
+            return datetime.toString(m_patterns[FarAway]);
     }
     return datetime.toString(Qt::DefaultLocaleShortDate);
 }
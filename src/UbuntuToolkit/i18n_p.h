@@ -19,15 +19,49 @@
 #ifndef I18N_P_H
 #define I18N_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
+class QDateTime;
 class QQmlContext;
 class QQmlEngine;
 
 UT_NAMESPACE_BEGIN
 
+class UbuntuI18n;
+
+// Formats the relative date times, keeping the locale flags and the translated patterns
+// until invalidated by a language or domain change.
+class UBUNTUTOOLKIT_EXPORT RelativeDateFormatter
+{
+public:
+    explicit RelativeDateFormatter(UbuntuI18n *i18n);
+
+    QString format(const QDateTime &datetime, const QDateTime &relativeTo);
+    void invalidate();
+
+private:
+    enum Pattern {
+        Today,
+        Yesterday,
+        Tomorrow,
+        Week,
+        FarAway,
+        PatternCount
+    };
+
+    void load();
+    QString minutes(qint64 minutes);
+
+    UbuntuI18n *m_i18n;
+    QString m_now;
+    QString m_patterns[PatternCount];
+    QHash<qint64, QString> m_minutes;
+    bool m_loaded:1;
+};
+
 class UBUNTUTOOLKIT_EXPORT UbuntuI18n : public QObject
 {
     Q_OBJECT
@@ -65,6 +99,14 @@ public:
     QString domain() const;
     QString language() const;
 
+    struct CacheStatistics {
+        quint64 hits;
+        quint64 misses;
+        // translations held by the cache
+        int count;
+    };
+    CacheStatistics cacheStatistics() const;
+
     // setter
     void setDomain(const QString& domain);
     void setLanguage(const QString& lang);
@@ -74,9 +116,37 @@ Q_SIGNALS:
     void languageChanged();
 
 private:
+    // Translations are cached per domain, context, source text and plural count, the domain
+    // being null for the current one. The cache holds the translations of the current
+    // language and domain, and is flushed when either changes. It is not locked, i18n being
+    // used from the GUI thread only.
+    struct TranslationKey {
+        QString domain;
+        QString context;
+        QString text;
+        QString plural;
+        int n;
+
+        bool operator==(const TranslationKey &other) const
+        {
+            return domain.isNull() == other.domain.isNull() && domain == other.domain
+                && context.isNull() == other.context.isNull() && context == other.context
+                && text == other.text && plural == other.plural && n == other.n;
+        }
+    };
+    friend uint qHash(const TranslationKey &key, uint seed);
+
+    bool findTranslation(const TranslationKey &key, QString *translation);
+    QString cacheTranslation(const TranslationKey &key, const QString &translation);
+    void flushTranslations();
+
     static UbuntuI18n *m_i18;
     QString m_domain;
     QString m_language;
+    RelativeDateFormatter m_relativeDateFormatter;
+    QHash<TranslationKey, QString> m_translations;
+    quint64 m_cacheHits;
+    quint64 m_cacheMisses;
 };
 
 UT_NAMESPACE_END
@@ -47,12 +47,21 @@ UT_NAMESPACE_BEGIN
         relativeTime: new Date()
     }
     \endqml
+
+    All the LiveTimers share a single timer, which emits their \l trigger signals in one go. When the
+    UBUNTU_UI_TOOLKIT_LIVETIMER_BUDGET environment variable is set to a number of milliseconds, the
+    signals left once that time is spent are emitted on the next iterations of the event loop,
+    spreading the updates of many timers over several frames.
 */
 LiveTimer::LiveTimer(QObject *parent)
     : QObject(parent)
     , m_frequency(Disabled)
     , m_effectiveFrequency(Disabled)
     , m_lastUpdate(0)
+    , m_relativeBucket(-1)
+    , m_slot(-1)
+    , m_slotIndex(-1)
+    , m_pending(false)
 {
 }
 
@@ -76,10 +85,11 @@ LiveTimer::~LiveTimer()
     \li \b LiveTimer.Second - emit the \l trigger signal on every change of second.
     \li \b LiveTimer.Minute - emit the \l trigger signal on every change of minute.
     \li \b LiveTimer.Hour - emit the \l trigger signal on every change of hour.
-    \li \b LiveTimer.Relative - emit the \l trigger signal periodically depending on how close current time is to to
-    \l relativeTime. If \l relativeTime is within 30 seconds of the current time, trigger every 30 seconds. Within an hour,
-    trigger every minute. Otherwise, trigger every hour until the relative time is more than a week past current time, after which
-    updates are disabled.
+    \li \b LiveTimer.Relative - emit the \l trigger signal when the text of
+    \l {i18n::relativeDateTime}{i18n.relativeDateTime()} changes for \l relativeTime. If \l relativeTime is within 30 seconds
+    of the current time, trigger when it gets further. Within an hour, trigger every minute. Otherwise, trigger when the day
+    proximity changes (i.e. today becomes yesterday) until the relative time is more than a week past current time, after
+    which updates are disabled.
 
     \note Setting the frequency to LiveTimer.Relative will disable the timer until a \l relativeTime is set.
 
@@ -16,6 +16,7 @@
 
 #include "livetimer_p_p.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtDBus/QDBusConnection>
 
 #include "timeutils_p.h"
@@ -26,10 +27,19 @@ UT_NAMESPACE_BEGIN
 
 SharedLiveTimer::SharedLiveTimer(QObject* parent)
     : QObject(parent)
+    , m_pendingIndex(0)
     , m_frequency(LiveTimer::Disabled)
+    , m_dispatchBudget(qMax(0, qEnvironmentVariableIntValue("UBUNTU_UI_TOOLKIT_LIVETIMER_BUDGET")))
 {
+    for (int slot = 0; slot < RelativeSlot; slot++) {
+        m_relativeCount[slot] = 0;
+    }
     m_timer.setSingleShot(true);
     connect(&m_timer, &QTimer::timeout, this, &SharedLiveTimer::timeout);
+    // the remaining triggers are emitted once the event loop got the chance to render
+    m_dispatchTimer.setSingleShot(true);
+    m_dispatchTimer.setInterval(0);
+    connect(&m_dispatchTimer, &QTimer::timeout, this, &SharedLiveTimer::dispatch);
 
     QDBusConnection::systemBus().connect(
         dbusService, QStringLiteral("/org/freedesktop/timedate1"),
@@ -37,40 +47,72 @@ SharedLiveTimer::SharedLiveTimer(QObject* parent)
         this, SLOT(timedate1PropertiesChanged(QString, QVariantMap, QStringList)));
 }
 
+void SharedLiveTimer::setDispatchBudget(int msecs)
+{
+    m_dispatchBudget = qMax(0, msecs);
+}
+
 void SharedLiveTimer::registerTimer(LiveTimer *timer)
 {
-    if (m_liveTimers.contains(timer)) {
-        unregisterTimer(timer);
+    if (timer->m_slot >= 0) {
+        removeTimer(timer);
+    }
+
+    LiveTimer::Frequency frequency = timer->frequency();
+    if (frequency == LiveTimer::Relative) {
+        QDateTime now(QDateTime::currentDateTime());
+        date_proximity_t proximity = getDateProximity(now, timer->relativeTime());
+        timer->m_relativeBucket = relativeTimeBucket(proximity, now, timer->relativeTime());
+        frequency = frequencyForProximity(proximity);
     }
-    m_liveTimers.append(timer);
+    insertTimer(timer, frequency);
     updateFrequency();
 }
 
 void SharedLiveTimer::unregisterTimer(LiveTimer *timer)
 {
-    if (!m_liveTimers.contains(timer)) return;
+    if (timer->m_slot < 0) return;
 
-    m_liveTimers.removeAll(timer);
+    removeTimer(timer);
     updateFrequency();
 }
 
-void SharedLiveTimer::updateFrequency()
+void SharedLiveTimer::insertTimer(LiveTimer *timer, LiveTimer::Frequency frequency)
 {
-    LiveTimer::Frequency newFreq = LiveTimer::Disabled;
-    if (m_liveTimers.count() == 0) {
-        newFreq = LiveTimer::Disabled;
+    timer->setEffectiveFrequency(frequency);
+    if (timer->frequency() == LiveTimer::Relative) {
+        timer->m_slot = RelativeSlot;
+        m_relativeCount[frequency]++;
     } else {
-        Q_FOREACH(LiveTimer* timer, m_liveTimers) {
-            LiveTimer::Frequency freq = timer->frequency();
-            if (freq == LiveTimer::Relative) {
-                date_proximity_t proximity = getDateProximity(QDateTime::currentDateTime(), timer->relativeTime());
-                freq = frequencyForProximity(proximity);
-            }
-            timer->setEffectiveFrequency(freq);
+        timer->m_slot = frequency;
+    }
+    timer->m_slotIndex = m_slots[timer->m_slot].size();
+    m_slots[timer->m_slot].append(timer);
+}
 
-            if (freq != LiveTimer::Disabled && (newFreq == LiveTimer::Disabled || freq < newFreq)) {
-                newFreq =  freq;
-            }
+// the last timer of the slot takes the place of the removed one
+void SharedLiveTimer::removeTimer(LiveTimer *timer)
+{
+    if (timer->m_slot == RelativeSlot) {
+        m_relativeCount[timer->effectiveFrequency()]--;
+    }
+    QVector<LiveTimer*> &slot = m_slots[timer->m_slot];
+    LiveTimer *last = slot.last();
+    slot[timer->m_slotIndex] = last;
+    last->m_slotIndex = timer->m_slotIndex;
+    slot.removeLast();
+    timer->m_slot = -1;
+    timer->m_slotIndex = -1;
+}
+
+// the timer ticks at the highest frequency having timers
+void SharedLiveTimer::updateFrequency()
+{
+    LiveTimer::Frequency newFreq = LiveTimer::Disabled;
+    for (int slot = LiveTimer::Second; slot <= LiveTimer::Hour; slot++) {
+        if (!m_slots[slot].isEmpty() || m_relativeCount[slot] > 0) {
+            newFreq = static_cast<LiveTimer::Frequency>(slot);
+            break;
         }
     }
     if (newFreq != m_frequency) {
@@ -109,6 +151,14 @@ void SharedLiveTimer::reInitTimer()
     m_timer.start(diff);
 }
 
+void SharedLiveTimer::enqueue(LiveTimer *timer)
+{
+    if (!timer->m_pending) {
+        timer->m_pending = true;
+        m_pending.append(timer);
+    }
+}
+
 void SharedLiveTimer::timeout()
 {
     QDateTime now(QDateTime::currentDateTime());
@@ -118,7 +168,12 @@ void SharedLiveTimer::timeout()
         reInitTimer();
         return;
     }
+    tick(now);
+}
 
+// triggers the timers due at the given time
+void SharedLiveTimer::tick(const QDateTime &now)
+{
     bool isHourUpdate = m_lastUpdate.date() != now.date() ||
             m_lastUpdate.time().hour() != now.time().hour();
     bool isMinuteUpdate = isHourUpdate ||
@@ -126,37 +181,61 @@ void SharedLiveTimer::timeout()
     bool isSecondUpdate = isMinuteUpdate ||
             m_lastUpdate.time().second() != now.time().second();
 
-    bool needsFrequencyUpdate = false;
-    QList<LiveTimer*> tmpTimers(m_liveTimers);
-    Q_FOREACH(LiveTimer* timer, tmpTimers) {
-
-        LiveTimer::Frequency effectiveFrequency = timer->effectiveFrequency();
-        if (effectiveFrequency == LiveTimer::Disabled) continue;
-
-        if (isHourUpdate) {
-            Q_EMIT timer->trigger();
-        } else if (isMinuteUpdate) {
-            if (effectiveFrequency >= LiveTimer::Second && effectiveFrequency <= LiveTimer::Minute) {
-                Q_EMIT timer->trigger();
-            }
-        } else if (isSecondUpdate) {
-            if (effectiveFrequency == LiveTimer::Second) {
-                Q_EMIT timer->trigger();
-            }
+    // only the slots due at this boundary are visited
+    int lastDueSlot = isHourUpdate ? LiveTimer::Hour
+        : (isMinuteUpdate ? LiveTimer::Minute : (isSecondUpdate ? LiveTimer::Second : LiveTimer::Disabled));
+    for (int slot = LiveTimer::Second; slot <= lastDueSlot; slot++) {
+        Q_FOREACH(LiveTimer* timer, m_slots[slot]) {
+            enqueue(timer);
         }
+    }
 
-        // re-evaluate relative timer frequency
-        if (timer->frequency() == LiveTimer::Relative) {
-            date_proximity_t newProximity = getDateProximity(now, timer->relativeTime());
-            needsFrequencyUpdate |= effectiveFrequency != frequencyForProximity(newProximity);
+    // relative timers are visited on every tick, they only trigger when the relative
+    // text of their time changes and follow the frequency of their new proximity
+    Q_FOREACH(LiveTimer* timer, m_slots[RelativeSlot]) {
+        date_proximity_t newProximity = getDateProximity(now, timer->relativeTime());
+        qint64 bucket = relativeTimeBucket(newProximity, now, timer->relativeTime());
+        if (bucket != timer->m_relativeBucket) {
+            timer->m_relativeBucket = bucket;
+            enqueue(timer);
+        }
+        LiveTimer::Frequency frequency = frequencyForProximity(newProximity);
+        if (frequency != timer->effectiveFrequency()) {
+            m_relativeCount[timer->effectiveFrequency()]--;
+            m_relativeCount[frequency]++;
+            timer->setEffectiveFrequency(frequency);
         }
     }
 
-    if (needsFrequencyUpdate) {
-        updateFrequency();
-    }
+    updateFrequency();
     reInitTimer();
     m_lastUpdate = now;
+    dispatch();
+}
+
+// emits the pending triggers, yielding to the event loop once the budget is spent
+void SharedLiveTimer::dispatch()
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (m_pendingIndex < m_pending.size()) {
+        LiveTimer *timer = m_pending[m_pendingIndex++].data();
+        // timers destroyed or unregistered since they got queued are skipped
+        if (!timer) {
+            continue;
+        }
+        timer->m_pending = false;
+        if (timer->m_slot >= 0) {
+            Q_EMIT timer->trigger();
+        }
+        if (m_dispatchBudget > 0 && m_pendingIndex < m_pending.size()
+                && elapsed.elapsed() >= m_dispatchBudget) {
+            m_dispatchTimer.start();
+            return;
+        }
+    }
+    m_pending.clear();
+    m_pendingIndex = 0;
 }
 
 void SharedLiveTimer::timedate1PropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &)
@@ -164,11 +243,18 @@ void SharedLiveTimer::timedate1PropertiesChanged(const QString &interface, const
     if (interface != dbusService) return;
     if (!changed.contains(QStringLiteral("Timezone"))) return;
 
-    QList<LiveTimer*> tmpTimers(m_liveTimers);
-    Q_FOREACH(LiveTimer* timer, tmpTimers) {
-        Q_EMIT timer->trigger();
+    QDateTime now(QDateTime::currentDateTime());
+    for (int slot = 0; slot < SlotCount; slot++) {
+        Q_FOREACH(LiveTimer* timer, m_slots[slot]) {
+            if (timer->frequency() == LiveTimer::Relative) {
+                date_proximity_t proximity = getDateProximity(now, timer->relativeTime());
+                timer->m_relativeBucket = relativeTimeBucket(proximity, now, timer->relativeTime());
+            }
+            enqueue(timer);
+        }
     }
     reInitTimer();
+    dispatch();
 }
 
 UT_NAMESPACE_END
@@ -65,6 +65,11 @@ private:
     Frequency m_effectiveFrequency;
     QDateTime m_relativeTime;
     quint64 m_lastUpdate;
+    qint64 m_relativeBucket;
+    // slot of the SharedLiveTimer wheel and position in it, -1 when not registered
+    int m_slot;
+    int m_slotIndex;
+    bool m_pending;
 
     friend class SharedLiveTimer;
 };
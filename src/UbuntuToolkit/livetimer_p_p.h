@@ -19,11 +19,15 @@
 
 #include <UbuntuToolkit/private/livetimer_p.h>
 
+#include <QtCore/QPointer>
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+class tst_LiveTimer;
 
 UT_NAMESPACE_BEGIN
 
-class SharedLiveTimer : public QObject
+class UBUNTUTOOLKIT_EXPORT SharedLiveTimer : public QObject
 {
     Q_OBJECT
 public:
@@ -38,23 +42,44 @@ public:
     void registerTimer(LiveTimer* timer);
     void unregisterTimer(LiveTimer* timer);
 
+    // milliseconds the triggers may take before yielding to the event loop, 0 for no limit
+    int dispatchBudget() const { return m_dispatchBudget; }
+    void setDispatchBudget(int msecs);
+
 private Q_SLOTS:
     void timeout();
+    void dispatch();
     void timedate1PropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList&);
 
 Q_SIGNALS:
     void trigger();
 
 private:
+    // the wheel has a slot per effective frequency, Disabled included, and a slot for
+    // the relative timers, visited on every tick whatever their effective frequency is
+    enum { RelativeSlot = LiveTimer::Relative, SlotCount = RelativeSlot + 1 };
+
+    void insertTimer(LiveTimer *timer, LiveTimer::Frequency frequency);
+    void removeTimer(LiveTimer *timer);
     void updateFrequency();
     void reInitTimer();
+    void enqueue(LiveTimer *timer);
+    void tick(const QDateTime &now);
 
-    QList<LiveTimer*> m_liveTimers;
+    QVector<LiveTimer*> m_slots[SlotCount];
+    // number of relative timers per effective frequency
+    int m_relativeCount[RelativeSlot];
+    QVector<QPointer<LiveTimer> > m_pending;
+    int m_pendingIndex;
     QTimer m_timer;
+    QTimer m_dispatchTimer;
     LiveTimer::Frequency m_frequency;
+    int m_dispatchBudget;
 
     QDateTime m_nextUpdate;
     QDateTime m_lastUpdate;
+
+    friend class ::tst_LiveTimer;
 };
 
 UT_NAMESPACE_END
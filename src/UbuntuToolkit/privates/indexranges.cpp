@@ -0,0 +1,186 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "indexranges_p.h"
+
+#include <algorithm>
+
+UT_NAMESPACE_BEGIN
+
+IndexRanges::IndexRanges()
+    : m_count(0)
+{
+}
+
+IndexRanges IndexRanges::fromList(const QList<int> &list)
+{
+    QVector<int> indexes = list.toVector();
+    std::sort(indexes.begin(), indexes.end());
+
+    IndexRanges result;
+    Q_FOREACH(int index, indexes) {
+        if (!result.m_ranges.isEmpty() && result.m_ranges.last().last >= index - 1) {
+            if (result.m_ranges.last().last < index) {
+                result.m_ranges.last().last = index;
+                result.m_count++;
+            }
+        } else {
+            result.m_ranges.append(Range{index, index});
+            result.m_count++;
+        }
+    }
+    return result;
+}
+
+QList<int> IndexRanges::toList() const
+{
+    QList<int> list;
+    list.reserve(m_count);
+    Q_FOREACH(const Range &range, m_ranges) {
+        for (int i = range.first; i <= range.last; i++) {
+            list.append(i);
+        }
+    }
+    return list;
+}
+
+// returns the position of the first range ending at or after index
+int IndexRanges::lowerBound(int index) const
+{
+    QVector<Range>::const_iterator it = std::lower_bound(m_ranges.constBegin(), m_ranges.constEnd(),
+        index, [](const Range &range, int value) { return range.last < value; });
+    return it - m_ranges.constBegin();
+}
+
+// returns the parts of the ranges falling between first and last
+QVector<IndexRanges::Range> IndexRanges::intersection(int first, int last) const
+{
+    QVector<Range> result;
+    for (int i = lowerBound(first); i < m_ranges.size() && m_ranges[i].first <= last; i++) {
+        result.append(Range{qMax(m_ranges[i].first, first), qMin(m_ranges[i].last, last)});
+    }
+    return result;
+}
+
+bool IndexRanges::contains(int index) const
+{
+    int i = lowerBound(index);
+    return i < m_ranges.size() && m_ranges[i].first <= index;
+}
+
+bool IndexRanges::insert(int first, int last)
+{
+    if (first > last) {
+        return false;
+    }
+    // merge all the ranges overlapping or touching the new one
+    const int begin = lowerBound(first - 1);
+    int end = begin;
+    int covered = 0;
+    Range merged{first, last};
+    while (end < m_ranges.size() && m_ranges[end].first <= last + 1) {
+        const Range &range = m_ranges[end];
+        merged.first = qMin(merged.first, range.first);
+        merged.last = qMax(merged.last, range.last);
+        covered += range.last - range.first + 1;
+        end++;
+    }
+    const int added = merged.last - merged.first + 1 - covered;
+    if (!added) {
+        return false;
+    }
+    if (begin < end) {
+        m_ranges[begin] = merged;
+        m_ranges.remove(begin + 1, end - begin - 1);
+    } else {
+        m_ranges.insert(begin, merged);
+    }
+    m_count += added;
+    return true;
+}
+
+bool IndexRanges::remove(int first, int last)
+{
+    if (first > last) {
+        return false;
+    }
+    // at most the first and last affected ranges leave a part outside of the removed one
+    const int begin = lowerBound(first);
+    int end = begin;
+    int removed = 0;
+    QVector<Range> remainders;
+    while (end < m_ranges.size() && m_ranges[end].first <= last) {
+        const Range &range = m_ranges[end];
+        if (range.first < first) {
+            remainders.append(Range{range.first, first - 1});
+        }
+        if (range.last > last) {
+            remainders.append(Range{last + 1, range.last});
+        }
+        removed += qMin(range.last, last) - qMax(range.first, first) + 1;
+        end++;
+    }
+    if (!removed) {
+        return false;
+    }
+    m_ranges.remove(begin, end - begin);
+    for (int i = 0; i < remainders.size(); i++) {
+        m_ranges.insert(begin + i, remainders[i]);
+    }
+    m_count -= removed;
+    return true;
+}
+
+bool IndexRanges::move(int from, int to)
+{
+    if (from == to) {
+        return false;
+    }
+    // the indexes between from and to are shifted towards from by one
+    const bool forwards = from < to;
+    const int first = forwards ? from + 1 : to;
+    const int last = forwards ? to : from - 1;
+    const int delta = forwards ? -1 : 1;
+
+    const bool fromContained = contains(from);
+    const QVector<Range> shifted = intersection(first, last);
+    if (!fromContained && shifted.isEmpty()) {
+        return false;
+    }
+    // rotating a fully contained span leaves it as it is
+    const int spanFirst = qMin(from, to);
+    const int spanLast = qMax(from, to);
+    int i = lowerBound(spanFirst);
+    if (m_ranges[i].first <= spanFirst && m_ranges[i].last >= spanLast) {
+        return false;
+    }
+    remove(spanFirst, spanLast);
+    Q_FOREACH(const Range &range, shifted) {
+        insert(range.first + delta, range.last + delta);
+    }
+    if (fromContained) {
+        insert(to, to);
+    }
+    return true;
+}
+
+void IndexRanges::clear()
+{
+    m_ranges.clear();
+    m_count = 0;
+}
+
+UT_NAMESPACE_END
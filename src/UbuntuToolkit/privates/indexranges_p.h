@@ -0,0 +1,76 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INDEXRANGES_P_H
+#define INDEXRANGES_P_H
+
+#include <QtCore/QList>
+#include <QtCore/QVector>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+UT_NAMESPACE_BEGIN
+
+// Set of indexes stored as sorted, disjoint and non-adjacent ranges, so a contiguous
+// selection of any length takes a single entry. Lookups are binary searches; the
+// modifiers return true when the set has changed so callers can notify once.
+class UBUNTUTOOLKIT_EXPORT IndexRanges
+{
+public:
+    struct Range {
+        int first;
+        int last;
+        bool operator==(const Range &other) const
+        {
+            return first == other.first && last == other.last;
+        }
+    };
+
+    IndexRanges();
+    static IndexRanges fromList(const QList<int> &list);
+
+    int count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    const QVector<Range> &ranges() const { return m_ranges; }
+    QList<int> toList() const;
+
+    bool contains(int index) const;
+    bool insert(int first, int last);
+    bool remove(int first, int last);
+    // moves the index from to index to, shifting the ones in between by one
+    bool move(int from, int to);
+    void clear();
+
+    bool operator==(const IndexRanges &other) const
+    {
+        return m_count == other.m_count && m_ranges == other.m_ranges;
+    }
+    bool operator!=(const IndexRanges &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    int lowerBound(int index) const;
+    QVector<Range> intersection(int first, int last) const;
+
+    QVector<Range> m_ranges;
+    int m_count;
+};
+
+UT_NAMESPACE_END
+
+#endif  // INDEXRANGES_P_H
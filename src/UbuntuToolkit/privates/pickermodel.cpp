@@ -0,0 +1,117 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pickermodel_p.h"
+
+UT_NAMESPACE_BEGIN
+
+UCPickerModel::UCPickerModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_from(0)
+    , m_modulo(0)
+    , m_count(0)
+{
+}
+
+int UCPickerModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant UCPickerModel::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole || index.row() < 0 || index.row() >= m_count) {
+        return QVariant();
+    }
+    return valueAt(index.row());
+}
+
+QHash<int, QByteArray> UCPickerModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(Qt::DisplayRole, QByteArrayLiteral("modelData"));
+    return roles;
+}
+
+void UCPickerModel::setFrom(int from)
+{
+    if (m_from != from) {
+        m_from = from;
+        if (m_count > 0) {
+            Q_EMIT dataChanged(index(0), index(m_count - 1));
+        }
+        Q_EMIT fromChanged();
+    }
+}
+
+void UCPickerModel::setModulo(int modulo)
+{
+    if (m_modulo != modulo) {
+        m_modulo = modulo;
+        if (m_count > 0) {
+            Q_EMIT dataChanged(index(0), index(m_count - 1));
+        }
+        Q_EMIT moduloChanged();
+    }
+}
+
+// Rows are removed then inserted rather than reset so that the Picker gets notified the same way
+// as when clearing and filling a ListModel.
+void UCPickerModel::resetRange(int from, int count)
+{
+    const int oldCount = m_count;
+    if (m_count > 0) {
+        beginRemoveRows(QModelIndex(), 0, m_count - 1);
+        m_count = 0;
+        endRemoveRows();
+    }
+    if (m_from != from) {
+        m_from = from;
+        Q_EMIT fromChanged();
+    }
+    if (count > 0) {
+        beginInsertRows(QModelIndex(), 0, count - 1);
+        m_count = count;
+        endInsertRows();
+    }
+    if (m_count != oldCount) {
+        Q_EMIT countChanged();
+    }
+}
+
+void UCPickerModel::resizeRange(int count)
+{
+    count = qMax(count, 0);
+    if (count > m_count) {
+        beginInsertRows(QModelIndex(), m_count, count - 1);
+        m_count = count;
+        endInsertRows();
+        Q_EMIT countChanged();
+    } else if (count < m_count) {
+        beginRemoveRows(QModelIndex(), count, m_count - 1);
+        m_count = count;
+        endRemoveRows();
+        Q_EMIT countChanged();
+    }
+}
+
+int UCPickerModel::valueAt(int index) const
+{
+    const int value = m_from + index;
+    return (m_modulo > 0) ? value % m_modulo : value;
+}
+
+UT_NAMESPACE_END
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PICKERMODEL_P_H
+#define PICKERMODEL_P_H
+
+#include <QtCore/QAbstractListModel>
+
+#include <UbuntuToolkit/ubuntutoolkitglobal.h>
+
+UT_NAMESPACE_BEGIN
+
+// Base of the DatePicker models. Rows hold consecutive values computed from the first value,
+// wrapped around the modulo if there is one, so the model doesn't store anything per row
+// whatever the range is. The single role is exposed to the delegates as modelData.
+class UBUNTUTOOLKIT_EXPORT UCPickerModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    // Value of the first row.
+    Q_PROPERTY(int from READ from WRITE setFrom NOTIFY fromChanged)
+
+    // Values are wrapped around the modulo if greater than 0 (i.e. 24 for hours).
+    Q_PROPERTY(int modulo READ modulo WRITE setModulo NOTIFY moduloChanged)
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    UCPickerModel(QObject* parent = 0);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int from() const { return m_from; }
+    void setFrom(int from);
+    int modulo() const { return m_modulo; }
+    void setModulo(int modulo);
+    int count() const { return m_count; }
+
+    // Replaces the rows with count values starting at from.
+    Q_INVOKABLE void resetRange(int from, int count);
+    // Appends or removes rows at the end.
+    Q_INVOKABLE void resizeRange(int count);
+    // Returns the value of the row at index.
+    Q_INVOKABLE int valueAt(int index) const;
+
+Q_SIGNALS:
+    void fromChanged();
+    void moduloChanged();
+    void countChanged();
+
+private:
+    int m_from;
+    int m_modulo;
+    int m_count;
+};
+
+UT_NAMESPACE_END
+
+#endif  // PICKERMODEL_P_H
@@ -25,8 +25,6 @@
 uniform sampler2D shapeTexture;
 uniform sampler2D sourceTexture;
 uniform lowp vec2 opacityFactors;
-uniform lowp float sourceOpacity;
-uniform lowp float distanceAA;
 uniform bool textured;
 uniform mediump int aspect;
 
@@ -34,6 +32,8 @@ varying mediump vec2 shapeCoord;
 varying mediump vec4 sourceCoord;
 varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
+varying mediump float distanceAA;
+varying lowp float sourceOpacity;
 
 const mediump int FLAT        = 0x08;  // 1 << 3
 const mediump int INSET       = 0x10;  // 1 << 4
@@ -16,12 +16,14 @@
 
 uniform highp mat4 matrix;  // mediump was interpreted as lowp on PowerVR Rogue G6200 (arale).
 uniform bool textured;
+uniform mediump float distanceAAScale;
 
 attribute highp vec4 positionAttrib;  // highp because of matrix precision qualifier.
 attribute mediump vec2 shapeCoordAttrib;
 attribute mediump vec4 sourceCoordAttrib;
 attribute lowp float yCoordAttrib;
 attribute lowp vec4 backgroundColorAttrib;
+attribute lowp vec4 shapeParametersAttrib;  // x: distance AA factor, y: source opacity.
 attribute mediump vec2 overlayCoordAttrib;
 attribute lowp vec4 overlayColorAttrib;
 
@@ -30,6 +32,8 @@ varying mediump vec2 shapeCoord;
 varying mediump vec4 sourceCoord;
 varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
+varying mediump float distanceAA;
+varying lowp float sourceOpacity;
 varying mediump vec2 overlayCoord;
 varying lowp vec4 overlayColor;
 
@@ -38,9 +42,11 @@ void main()
     shapeCoord = shapeCoordAttrib;
     if (textured) {
         sourceCoord = sourceCoordAttrib;
+        sourceOpacity = shapeParametersAttrib.y;
     }
     yCoord = yCoordAttrib;
     backgroundColor = backgroundColorAttrib;
+    distanceAA = distanceAAScale * shapeParametersAttrib.x;
     overlayCoord = overlayCoordAttrib;
     overlayColor = overlayColorAttrib;
 
@@ -24,8 +24,6 @@ uniform sampler2D shapeTexture;
 uniform sampler2D sourceTexture;
 uniform lowp vec2 opacityFactors;
 uniform lowp float dfdtFactor;
-uniform lowp float sourceOpacity;
-uniform lowp float distanceAA;
 uniform bool textured;
 uniform mediump int aspect;
 
@@ -33,6 +31,7 @@ varying mediump vec2 shapeCoord;
 varying mediump vec4 sourceCoord;
 varying lowp float yCoord;
 varying lowp vec4 backgroundColor;
+varying lowp float sourceOpacity;
 varying mediump vec2 overlayCoord;
 varying lowp vec4 overlayColor;
 
@@ -20,8 +20,150 @@
 
 #include "sortfiltermodel_p.h"
 
+#include <QtCore/QDateTime>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+#include <QtQml/QJSEngine>
+#include <QtQml/QQmlEngine>
+
 UT_NAMESPACE_BEGIN
 
+// Number of rows of each chunk when filtering is spread over the global thread pool.
+const int filterTaskRowCount = 4096;
+
+// Matches the filter keys of the rows in [first, last[. When narrowing, only the rows accepted by
+// the previous filter are matched. QRegExp stores the state of the last match so each task needs
+// its own copy.
+static void matchFilterKeys(const QString *keys, bool *accepted, int first, int last,
+                            QRegExp regExp, bool narrowing)
+{
+    for (int i = first; i < last; i++) {
+        if (!narrowing || accepted[i]) {
+            accepted[i] = keys[i].contains(regExp);
+        }
+    }
+}
+
+// Chunks of a filter update, claimed one at a time by the calling thread and the pool threads
+// so that the caller never waits for a chunk no thread started.
+struct FilterJob
+{
+    FilterJob(const QString *keys, bool *accepted, int count, const QRegExp &regExp, bool narrowing)
+        : keys(keys), accepted(accepted), count(count), regExp(regExp), narrowing(narrowing)
+        , nextChunk(0)
+    {
+    }
+
+    int chunkCount() const
+    {
+        return (count + filterTaskRowCount - 1) / filterTaskRowCount;
+    }
+
+    void matchChunks()
+    {
+        int chunk;
+        while ((chunk = nextChunk.fetchAndAddRelaxed(1)) < chunkCount()) {
+            const int first = chunk * filterTaskRowCount;
+            matchFilterKeys(keys, accepted, first, qMin(first + filterTaskRowCount, count),
+                            regExp, narrowing);
+            done.release();
+        }
+    }
+
+    const QString *keys;
+    bool *accepted;
+    int count;
+    QRegExp regExp;
+    bool narrowing;
+    QAtomicInt nextChunk;
+    QSemaphore done;
+};
+
+// Tasks starting once the caller matched all the chunks find nothing left to do, the job is
+// shared so that it outlives them.
+class FilterTask : public QRunnable
+{
+public:
+    FilterTask(const QSharedPointer<FilterJob> &job)
+        : m_job(job)
+    {
+    }
+
+    void run() override
+    {
+        m_job->matchChunks();
+    }
+
+private:
+    QSharedPointer<FilterJob> m_job;
+};
+
+// Returns true if the pattern is a plain string, typically typed in a search field.
+static bool isPlainString(const QRegExp &regExp)
+{
+    if (regExp.patternSyntax() == QRegExp::FixedString) {
+        return true;
+    }
+    if (regExp.patternSyntax() != QRegExp::RegExp && regExp.patternSyntax() != QRegExp::RegExp2) {
+        return false;
+    }
+    static const QString metaCharacters(QStringLiteral("\\^$.|?*+()[]{}"));
+    Q_FOREACH(const QChar &c, regExp.pattern()) {
+        if (metaCharacters.contains(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns true if all the strings matching regExp also match previousRegExp, in which case only
+// the rows accepted by the previous filter have to be matched again.
+static bool isNarrowing(const QRegExp &regExp, const QRegExp &previousRegExp)
+{
+    return regExp.caseSensitivity() == previousRegExp.caseSensitivity()
+        && isPlainString(regExp) && isPlainString(previousRegExp)
+        && regExp.pattern().contains(previousRegExp.pattern(), regExp.caseSensitivity());
+}
+
+// Same ordering as QSortFilterProxyModel::lessThan().
+static bool variantLessThan(const QVariant &left, const QVariant &right,
+                            Qt::CaseSensitivity caseSensitivity, bool localeAware)
+{
+    switch (left.userType()) {
+    case QVariant::Invalid:
+        return right.type() != QVariant::Invalid;
+    case QVariant::Int:
+        return left.toInt() < right.toInt();
+    case QVariant::UInt:
+        return left.toUInt() < right.toUInt();
+    case QVariant::LongLong:
+        return left.toLongLong() < right.toLongLong();
+    case QVariant::ULongLong:
+        return left.toULongLong() < right.toULongLong();
+    case QMetaType::Float:
+        return left.toFloat() < right.toFloat();
+    case QVariant::Double:
+        return left.toDouble() < right.toDouble();
+    case QVariant::Char:
+        return left.toChar() < right.toChar();
+    case QVariant::Date:
+        return left.toDate() < right.toDate();
+    case QVariant::Time:
+        return left.toTime() < right.toTime();
+    case QVariant::DateTime:
+        return left.toDateTime() < right.toDateTime();
+    case QVariant::String:
+    default:
+        if (localeAware) {
+            return left.toString().localeAwareCompare(right.toString()) < 0;
+        } else {
+            return left.toString().compare(right.toString(), caseSensitivity) < 0;
+        }
+    }
+}
+
 /*!
  * \qmltype SortFilterModel
  * \inqmlmodule Ubuntu.Components
@@ -102,6 +244,9 @@ UT_NAMESPACE_BEGIN
 
 QSortFilterProxyModelQML::QSortFilterProxyModelQML(QObject *parent)
     : QSortFilterProxyModel(parent)
+    , m_filterKeysRole(-1)
+    , m_sortKeysRole(-1)
+    , m_acceptedRowsValid(false)
 {
     // This is virtually always what you want in QML
     setDynamicSortFilter(true);
@@ -114,18 +259,43 @@ QSortFilterProxyModelQML::QSortFilterProxyModelQML(QObject *parent)
     connect(&m_filterBehavior, &FilterBehavior::patternChanged, this, &QSortFilterProxyModelQML::filterChangedInternal);
 }
 
-int
-QSortFilterProxyModelQML::roleByName(const QString& roleName) const
+void
+QSortFilterProxyModelQML::cacheRoles() const
 {
-    const QByteArray roleNameByteArray = roleName.toUtf8();
+    if (!m_roleIds.isEmpty()) {
+        return;
+    }
     const QHash<int, QByteArray> roles = roleNames();
+    m_roleKeys.reserve(roles.size());
     QHashIterator<int, QByteArray> i(roles);
     while (i.hasNext()) {
         i.next();
-        if (i.value() == roleNameByteArray)
-            return i.key();
+        m_roleIds.insert(i.value(), i.key());
+        m_roleKeys.append(qMakePair(i.key(), QString::fromUtf8(i.value())));
+    }
+}
+
+void
+QSortFilterProxyModelQML::clearRoleCache()
+{
+    m_roleIds.clear();
+    m_roleKeys.clear();
+}
+
+// models such as ListModel gain roles as data is added, the cache follows the source roles
+void
+QSortFilterProxyModelQML::checkRoleCache()
+{
+    if (!m_roleKeys.isEmpty() && sourceModel() && sourceModel()->roleNames().size() != m_roleKeys.size()) {
+        clearRoleCache();
     }
-    return 0;
+}
+
+int
+QSortFilterProxyModelQML::roleByName(const QString& roleName) const
+{
+    cacheRoles();
+    return m_roleIds.value(roleName.toUtf8(), 0);
 }
 
 /*!
@@ -179,7 +349,14 @@ QSortFilterProxyModelQML::filterBehavior()
 void
 QSortFilterProxyModelQML::sortChangedInternal()
 {
-    setSortRole(roleByName(m_sortBehavior.property()));
+    const int role = roleByName(m_sortBehavior.property());
+    if (m_sortBehavior.property().isEmpty()) {
+        m_sortKeys.clear();
+        m_sortKeysRole = -1;
+    } else {
+        updateSortKeys(role);
+    }
+    setSortRole(role);
     sort(sortColumn() != -1 ? sortColumn() : 0, m_sortBehavior.order());
     Q_EMIT sortChanged();
 }
@@ -187,11 +364,206 @@ QSortFilterProxyModelQML::sortChangedInternal()
 void
 QSortFilterProxyModelQML::filterChangedInternal()
 {
-    setFilterRole(roleByName(m_filterBehavior.property()));
-    setFilterRegExp(m_filterBehavior.pattern());
+    // The filter is evaluated on the cached keys before being set on the proxy model, which then
+    // only has to look up the results and emit the rows insertions and removals.
+    const int role = roleByName(m_filterBehavior.property());
+    const QRegExp regExp = m_filterBehavior.pattern();
+    if (regExp.isEmpty()) {
+        m_acceptedRowsValid = false;
+    } else {
+        updateFilterKeys(role);
+        updateAcceptedRows(regExp);
+    }
+    setFilterRole(role);
+    setFilterRegExp(regExp);
     Q_EMIT filterChanged();
 }
 
+void
+QSortFilterProxyModelQML::connectToSourceModel(QAbstractItemModel *model)
+{
+    connect(model, &QAbstractItemModel::rowsInserted,
+            this, &QSortFilterProxyModelQML::sourceRowsInserted);
+    connect(model, &QAbstractItemModel::rowsRemoved,
+            this, &QSortFilterProxyModelQML::sourceRowsRemoved);
+    connect(model, &QAbstractItemModel::dataChanged,
+            this, &QSortFilterProxyModelQML::sourceDataChanged);
+    connect(model, &QAbstractItemModel::rowsMoved,
+            this, &QSortFilterProxyModelQML::sourceLayoutChanged);
+    connect(model, &QAbstractItemModel::layoutChanged,
+            this, &QSortFilterProxyModelQML::sourceLayoutChanged);
+    connect(model, &QAbstractItemModel::modelReset,
+            this, &QSortFilterProxyModelQML::sourceModelReset);
+}
+
+void
+QSortFilterProxyModelQML::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    const int count = last - first + 1;
+    if (m_filterKeysRole != -1) {
+        m_filterKeys.insert(first, count, QString());
+    }
+    if (m_acceptedRowsValid) {
+        m_acceptedRows.insert(first, count, true);
+    }
+    if (m_sortKeysRole != -1) {
+        m_sortKeys.insert(first, count, QVariant());
+    }
+    checkRoleCache();
+    fetchRows(first, last);
+}
+
+void
+QSortFilterProxyModelQML::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    const int count = last - first + 1;
+    if (m_filterKeysRole != -1) {
+        m_filterKeys.remove(first, count);
+    }
+    if (m_acceptedRowsValid) {
+        m_acceptedRows.remove(first, count);
+    }
+    if (m_sortKeysRole != -1) {
+        m_sortKeys.remove(first, count);
+    }
+}
+
+void
+QSortFilterProxyModelQML::sourceDataChanged(const QModelIndex &topLeft,
+                                            const QModelIndex &bottomRight,
+                                            const QVector<int> &roles)
+{
+    if (topLeft.parent().isValid()) {
+        return;
+    }
+    checkRoleCache();
+    if (roles.isEmpty() || roles.contains(m_filterKeysRole) || roles.contains(m_sortKeysRole)) {
+        fetchRows(topLeft.row(), bottomRight.row());
+    }
+}
+
+void
+QSortFilterProxyModelQML::sourceLayoutChanged()
+{
+    rebuildRowCaches();
+}
+
+void
+QSortFilterProxyModelQML::sourceModelReset()
+{
+    clearRoleCache();
+    rebuildRowCaches();
+}
+
+void
+QSortFilterProxyModelQML::invalidateRowCaches()
+{
+    m_filterKeys.clear();
+    m_filterKeysRole = -1;
+    m_acceptedRows.clear();
+    m_acceptedRowsValid = false;
+    m_sortKeys.clear();
+    m_sortKeysRole = -1;
+}
+
+void
+QSortFilterProxyModelQML::rebuildRowCaches()
+{
+    invalidateRowCaches();
+    if (!m_sortBehavior.property().isEmpty()) {
+        updateSortKeys(roleByName(m_sortBehavior.property()));
+    }
+    const QRegExp regExp = m_filterBehavior.pattern();
+    if (!regExp.isEmpty()) {
+        updateFilterKeys(roleByName(m_filterBehavior.property()));
+        updateAcceptedRows(regExp);
+    }
+}
+
+void
+QSortFilterProxyModelQML::fetchRows(int first, int last)
+{
+    QAbstractItemModel *model = sourceModel();
+    for (int i = first; i <= last; i++) {
+        const QModelIndex index = model->index(i, 0);
+        if (m_filterKeysRole != -1) {
+            m_filterKeys[i] = index.data(m_filterKeysRole).toString();
+            if (m_acceptedRowsValid) {
+                m_acceptedRows[i] = m_filterKeys.at(i).contains(m_acceptedRowsRegExp);
+            }
+        }
+        if (m_sortKeysRole != -1) {
+            m_sortKeys[i] = index.data(m_sortKeysRole);
+        }
+    }
+}
+
+void
+QSortFilterProxyModelQML::updateFilterKeys(int role)
+{
+    QAbstractItemModel *model = sourceModel();
+    const int count = model ? model->rowCount() : 0;
+    if (role == m_filterKeysRole && m_filterKeys.size() == count) {
+        return;
+    }
+    m_filterKeysRole = role;
+    m_filterKeys.resize(count);
+    for (int i = 0; i < count; i++) {
+        m_filterKeys[i] = model->index(i, 0).data(role).toString();
+    }
+    m_acceptedRowsValid = false;
+}
+
+void
+QSortFilterProxyModelQML::updateSortKeys(int role)
+{
+    QAbstractItemModel *model = sourceModel();
+    const int count = model ? model->rowCount() : 0;
+    if (role == m_sortKeysRole && m_sortKeys.size() == count) {
+        return;
+    }
+    m_sortKeysRole = role;
+    m_sortKeys.resize(count);
+    for (int i = 0; i < count; i++) {
+        m_sortKeys[i] = model->index(i, 0).data(role);
+    }
+}
+
+void
+QSortFilterProxyModelQML::updateAcceptedRows(const QRegExp &regExp)
+{
+    const int count = m_filterKeys.size();
+    const bool narrowing = m_acceptedRowsValid && m_acceptedRows.size() == count
+        && isNarrowing(regExp, m_acceptedRowsRegExp);
+    if (!narrowing) {
+        m_acceptedRows.fill(true, count);
+    }
+    m_acceptedRowsRegExp = regExp;
+    m_acceptedRowsValid = true;
+
+    // Big models are split in chunks matched in parallel, the calling thread included.
+    const QString *keys = m_filterKeys.constData();
+    bool *accepted = m_acceptedRows.data();
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if (count >= 2 * filterTaskRowCount && pool->maxThreadCount() > 1) {
+        QSharedPointer<FilterJob> job(new FilterJob(keys, accepted, count, regExp, narrowing));
+        const int taskCount = qMin(job->chunkCount() - 1, pool->maxThreadCount());
+        for (int i = 0; i < taskCount; i++) {
+            pool->start(new FilterTask(job));
+        }
+        job->matchChunks();
+        job->done.acquire(job->chunkCount());
+    } else {
+        matchFilterKeys(keys, accepted, 0, count, regExp, narrowing);
+    }
+}
+
 QHash<int, QByteArray> QSortFilterProxyModelQML::roleNames() const
 {
     return sourceModel() ? sourceModel()->roleNames() : QHash<int, QByteArray>();
@@ -214,7 +586,13 @@ QSortFilterProxyModelQML::setModel(QAbstractItemModel *itemModel)
             sourceModel()->disconnect(this);
         }
 
+        // Connected before the proxy model sets up its own connections, so that the row caches
+        // are up to date by the time it handles source model changes.
+        connectToSourceModel(itemModel);
+        clearRoleCache();
+        invalidateRowCaches();
         setSourceModel(itemModel);
+        rebuildRowCaches();
         // Roles mapping to role names may change
         setSortRole(roleByName(m_sortBehavior.property()));
         setFilterRole(roleByName(m_filterBehavior.property()));
@@ -222,15 +600,60 @@ QSortFilterProxyModelQML::setModel(QAbstractItemModel *itemModel)
     }
 }
 
+/*!
+ * \qmlmethod object SortFilterModel::get(int row)
+ *
+ * Returns an object holding the values of all the roles of the given \a row. The object is
+ * empty if the row doesn't exist.
+ */
 QVariantMap
 QSortFilterProxyModelQML::get(int row)
 {
     QVariantMap res;
-    const QHash<int, QByteArray> roles = roleNames();
-    QHashIterator<int, QByteArray> i(roles);
-    while (i.hasNext()) {
-        i.next();
-        res.insert(QString::fromUtf8(i.value()), index(row, 0).data(i.key()));
+    const QModelIndex sourceIndex = mapToSource(index(row, 0));
+    if (!sourceIndex.isValid()) {
+        return res;
+    }
+    cacheRoles();
+    QAbstractItemModel *model = sourceModel();
+    for (int i = 0; i < m_roleKeys.size(); i++) {
+        const QPair<int, QString> &role = m_roleKeys.at(i);
+        res.insert(role.second, model->data(sourceIndex, role.first));
+    }
+    return res;
+}
+
+/*!
+ * \qmlmethod list<object> SortFilterModel::getRange(int from, int count)
+ *
+ * Returns an array of \a count objects, as returned by \l get(), starting at row \a from. The
+ * range is clamped to the rows of the model. Use it rather than calling \l get() in a loop when
+ * iterating over many rows.
+ */
+QJSValue
+QSortFilterProxyModelQML::getRange(int from, int count)
+{
+    QJSEngine *engine = qmlEngine(this);
+    if (engine == NULL) {
+        return QJSValue();
+    }
+
+    from = qMax(from, 0);
+    // clamped before adding, so that large counts don't overflow
+    count = qMax(qMin(count, rowCount() - from), 0);
+    const int to = from + count;
+    QJSValue res = engine->newArray(count);
+    cacheRoles();
+    QAbstractItemModel *model = sourceModel();
+    for (int row = from; row < to; row++) {
+        const QModelIndex sourceIndex = mapToSource(index(row, 0));
+        QJSValue item = engine->newObject();
+        for (int i = 0; i < m_roleKeys.size(); i++) {
+            const QPair<int, QString> &role = m_roleKeys.at(i);
+            item.setProperty(role.second,
+                             engine->toScriptValue(model->data(sourceIndex, role.first)));
+        }
+        res.setProperty(row - from, item);
     }
     return res;
 }
@@ -248,9 +671,26 @@ QSortFilterProxyModelQML::filterAcceptsRow(int sourceRow,
     if (filterRegExp().isEmpty()) {
         return true;
     }
+    if (m_acceptedRowsValid && !sourceParent.isValid() && sourceRow < m_acceptedRows.size()) {
+        return m_acceptedRows.at(sourceRow);
+    }
 
     bool result = QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
     return result;
 }
 
+bool
+QSortFilterProxyModelQML::lessThan(const QModelIndex &sourceLeft,
+                                   const QModelIndex &sourceRight) const
+{
+    const int left = sourceLeft.row();
+    const int right = sourceRight.row();
+    if (m_sortKeysRole == sortRole() && left < m_sortKeys.size() && right < m_sortKeys.size()
+        && !sourceLeft.parent().isValid()) {
+        return variantLessThan(m_sortKeys.at(left), m_sortKeys.at(right), sortCaseSensitivity(),
+                               isSortLocaleAware());
+    }
+    return QSortFilterProxyModel::lessThan(sourceLeft, sourceRight);
+}
+
 UT_NAMESPACE_END
@@ -22,6 +22,8 @@
 #define SORTFILTERMODEL_P_H
 
 #include <QtCore/QSortFilterProxyModel>
+#include <QtCore/QVector>
+#include <QtQml/QJSValue>
 
 #include <UbuntuToolkit/private/sortbehavior_p.h>
 #include <UbuntuToolkit/private/filterbehavior_p.h>
@@ -46,8 +48,10 @@ public:
     explicit QSortFilterProxyModelQML(QObject *parent = 0);
 
     Q_INVOKABLE QVariantMap get(int row);
+    Q_INVOKABLE QJSValue getRange(int from, int count);
     Q_INVOKABLE int count();
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const override;
 
     /* getters */
     QHash<int, QByteArray> roleNames() const override;
@@ -70,6 +74,36 @@ private:
     FilterBehavior* filterBehavior();
     void filterChangedInternal();
     int roleByName(const QString& roleName) const;
+    void cacheRoles() const;
+    void clearRoleCache();
+    void checkRoleCache();
+
+    // Row caches, indexed by source row, so that sorting and filtering don't go through the source
+    // model (which is slow with QML models) for each comparison.
+    void connectToSourceModel(QAbstractItemModel *model);
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                           const QVector<int> &roles);
+    void sourceLayoutChanged();
+    void sourceModelReset();
+    void invalidateRowCaches();
+    void rebuildRowCaches();
+    void fetchRows(int first, int last);
+    void updateFilterKeys(int role);
+    void updateSortKeys(int role);
+    void updateAcceptedRows(const QRegExp &regExp);
+
+    mutable QHash<QByteArray, int> m_roleIds;
+    // Role ids with their names converted once, so that get() doesn't allocate keys for each row.
+    mutable QVector<QPair<int, QString> > m_roleKeys;
+    QVector<QString> m_filterKeys;
+    QVector<QVariant> m_sortKeys;
+    QVector<bool> m_acceptedRows;
+    QRegExp m_acceptedRowsRegExp;
+    int m_filterKeysRole;
+    int m_sortKeysRole;
+    bool m_acceptedRowsValid;
 };
 
 UT_NAMESPACE_END
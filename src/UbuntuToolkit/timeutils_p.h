@@ -120,6 +120,23 @@ inline date_proximity_t getDateProximity(const QDateTime& now, const QDateTime&
    }
 }
 
+// distance in minutes used when the time is within the hour
+inline qint64 getProximityMinutes(const QDateTime& now, const QDateTime& time)
+{
+    qint64 diff = time.toMSecsSinceEpoch() - now.toMSecsSinceEpoch();
+    return qRound(float(diff) / 60000);
+}
+
+/* Identifies the relative text of a time: it only changes with the proximity, or with the
+  distance in minutes while within the hour, the other texts being absolute times */
+inline qint64 relativeTimeBucket(date_proximity_t proximity, const QDateTime& now, const QDateTime& time)
+{
+    if (proximity == DATE_PROXIMITY_HOUR) {
+        return getProximityMinutes(now, time) * 16 + proximity;
+    }
+    return proximity;
+}
+
 inline LiveTimer::Frequency frequencyForProximity(date_proximity_t proximity) {
     switch(proximity) {
         case DATE_PROXIMITY_NOW:
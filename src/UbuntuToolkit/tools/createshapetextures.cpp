@@ -63,7 +63,6 @@ static double gradientY[biggestSize];
 
 // Final texture buffers.
 static uint textureData[size];
-static uint textureDataMipmap[sizeMipmap];
 
 // Clear rendering buffer.
 static void clearRenderBuffer()
@@ -402,45 +401,17 @@ int main(int argc, char* argv[])
     cppOut << "};\n\n";
     painter.end();
 
-    // Create the mipmap textures and write them to the C++ file.
+    // Write the mipmap textures info to the C++ file. The mipmap textures themselves are created
+    // at runtime from the distance field textures, see createShapeTextureMipmaps() in the
+    // UbuntuShape implementation.
+    int size = 0;
+    for (int i = 0; i < mipmapCount; i++) {
+        size += (widthMipmap >> i) * (heightMipmap >> i) * 4;
+    }
     cppOut << "const int shapeTextureMipmapWidth = " << widthMipmap << ";\n"
            << "const int shapeTextureMipmapHeight = " << heightMipmap << ";\n"
            << "const int shapeTextureMipmapCount = " << mipmapCount << ";\n"
-           << "static const int shapeTextureMipmapOffset[" << mipmapCount << "] = {\n"
-           << "    0";
-    int size = 0, i = 0;
-    for (int i = 0; i < mipmapCount-1; i++) {
-        size += (widthMipmap >> i) * (heightMipmap >> i) * 4;
-        cppOut << ", " << size;
-    }
-    size += (widthMipmap >> (mipmapCount-1)) * (heightMipmap >> (mipmapCount-1)) * 4;
-    cppOut << "\n};\n";
-    cppOut << "static const unsigned char shapeTextureMipmapData[" << textureCount
-           <<   "][" << size + 1 << "] = {\n";
-    for (int i = 0; i < mipmapCount; i++) {
-        const int width = widthMipmap >> i;
-        const int height = heightMipmap >> i;
-        QImage shapeMipmap(reinterpret_cast<uchar*>(renderBuffer), width, height,
-                           width * 4, QImage::Format_ARGB32_Premultiplied);
-        painter.begin(&shapeMipmap);
-        createTexture1(&svg, &painter, textureDataMipmap, width, height, false);
-        cppOut << "    // Mipmap level " << i << ".\n";
-        dumpTexture(cppOut, textureDataMipmap, width * height);
-        painter.end();
-    }
-    cppOut << "    ,\n";
-    for (int i = 0; i < mipmapCount; i++) {
-        const int width = widthMipmap >> i;
-        const int height = heightMipmap >> i;
-        QImage shapeMipmap(reinterpret_cast<uchar*>(renderBuffer), width, height,
-                           width * 4, QImage::Format_ARGB32_Premultiplied);
-        painter.begin(&shapeMipmap);
-        createTexture2(&svg, &painter, textureDataMipmap, width, height, false);
-        cppOut << "    // Mipmap level " << i << ".\n";
-        dumpTexture(cppOut, textureDataMipmap, width * height);
-        painter.end();
-    }
-    cppOut << "};\n";
+           << "const int shapeTextureMipmapSize = " << size << ";\n";
 
     return 0;
 }
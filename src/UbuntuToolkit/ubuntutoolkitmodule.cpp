@@ -45,6 +45,7 @@
 #include "menugroup_p.h"
 #include "privates/appheaderbase_p.h"
 #include "privates/frame_p.h"
+#include "privates/pickermodel_p.h"
 #include "privates/ucpagewrapper_p.h"
 #include "privates/ucscrollbarutils_p.h"
 #include "qquickclipboard_p.h"
@@ -262,6 +263,7 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
     qmlRegisterType<UCPageWrapper>(privateUri, 1, 3, "PageWrapper");
     qmlRegisterType<UCAppHeaderBase>(privateUri, 1, 3, "AppHeaderBase");
     qmlRegisterType<Tree>(privateUri, 1, 3, "Tree");
+    qmlRegisterType<UCPickerModel>(privateUri, 1, 3, "PickerModel");
 
     //FIXME: move to a more generic location, i.e StyledItem or QuickUtils
     qmlRegisterSimpleSingletonType<UCScrollbarUtils>(privateUri, 1, 3, "PrivateScrollbarUtils");
@@ -306,6 +308,8 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
                 filter |= UMApplicationMonitor::FrameEvent;
             } else if (filterList[i] == QStringLiteral("generic")) {
                 filter |= UMApplicationMonitor::GenericEvent;
+            } else if (filterList[i] == QStringLiteral("framesummary")) {
+                filter |= UMApplicationMonitor::FrameSummaryEvent;
             }
         }
         applicationMonitor->setLoggingFilter(filter);
@@ -319,6 +323,14 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
         } else if (metricsLogging == "lttng") {
             logger = new UMLTTNGLogger();
 #endif  // defined(Q_OS_LINUX)
+        } else if (metricsLogging.startsWith("binary:")) {
+            logger = new UMBinaryFileLogger(
+                QString::fromLocal8Bit(metricsLogging.mid(sizeof("binary:") - 1)));
+        } else if (metricsLogging == "flightrecorder"
+                   || metricsLogging.startsWith("flightrecorder:")) {
+            const int duration = metricsLogging.mid(sizeof("flightrecorder:") - 1).toInt();
+            logger = duration > 0
+                ? new UMFlightRecorderLogger(duration) : new UMFlightRecorderLogger();
         } else {
             logger = new UMFileLogger(QString::fromLocal8Bit(metricsLogging));
         }
@@ -128,7 +128,8 @@ UT_NAMESPACE_BEGIN
 
 UCAlarmModel::UCAlarmModel(QObject *parent)
     : QAbstractListModel(parent)
-    , m_moved(false)
+    , m_movedTo(-1)
+    , m_reset(false)
 {
     // keep in sync with alarms collection changes
     // some of the connections can be asynchronous, others synchronous
@@ -250,20 +251,25 @@ void UCAlarmModel::refresh()
 
 /*!
  * \internal
- * The slot prepares the model reset.
+ * The slot prepares the model reset. The alarms are only reset when there was
+ * none before the refresh, otherwise the changes are reported one by one.
  */
 void UCAlarmModel::refreshStart()
 {
     beginResetModel();
+    m_reset = true;
 }
 
 /*!
  * \internal
- * The slot finalizes the model reset.
+ * The slot finalizes the model refresh.
  */
 void UCAlarmModel::refreshEnd()
 {
-    endResetModel();
+    if (m_reset) {
+        endResetModel();
+        m_reset = false;
+    }
     Q_EMIT countChanged();
 }
 
@@ -322,10 +328,13 @@ void UCAlarmModel::insertFinished()
  */
 void UCAlarmModel::moveStarted(int from, int to)
 {
-    if (m_moved) {
+    if (m_movedTo >= 0) {
         return;
     }
-    m_moved = beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+    // the destination is the row the alarm is moved before
+    if (beginMoveRows(QModelIndex(), from, from, QModelIndex(), (to > from) ? to + 1 : to)) {
+        m_movedTo = to;
+    }
 }
 
 /*!
@@ -334,10 +343,12 @@ void UCAlarmModel::moveStarted(int from, int to)
  */
 void UCAlarmModel::moveFinished()
 {
-    if (m_moved) {
+    if (m_movedTo >= 0) {
         endMoveRows();
+        // the alarm moved because its data changed
+        update(m_movedTo);
     }
-    m_moved = false;
+    m_movedTo = -1;
 }
 
 UT_NAMESPACE_END
@@ -68,7 +68,8 @@ private Q_SLOTS:
     void moveFinished();
 
 private:
-    bool m_moved:1;
+    int m_movedTo;
+    bool m_reset:1;
 };
 
 UT_NAMESPACE_END
@@ -56,6 +56,8 @@ UCBottomEdgePrivate::UCBottomEdgePrivate()
     , mousePressed(false)
     , preloadContent(false)
 {
+    // the bottom panel is set up right after the style is loaded
+    asynchronousStyleSupported = false;
 }
 
 void UCBottomEdgePrivate::init()
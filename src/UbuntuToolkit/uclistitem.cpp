@@ -216,6 +216,8 @@ UCListItemPrivate::UCListItemPrivate()
 {
     // the ListItem is not a focus scope
     isFocusScope = false;
+    // the style panels are set up right after the style is loaded
+    asynchronousStyleSupported = false;
 }
 UCListItemPrivate::~UCListItemPrivate()
 {
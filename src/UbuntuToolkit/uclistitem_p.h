@@ -210,6 +210,8 @@ public:
     void setSelectMode(bool value);
     QList<int> selectedIndices() const;
     void setSelectedIndices(const QList<int> &list);
+    Q_INVOKABLE void selectRange(int from, int to);
+    Q_INVOKABLE void selectAll();
     bool dragMode() const;
     void setDragMode(bool value);
 
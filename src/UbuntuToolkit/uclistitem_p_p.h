@@ -23,6 +23,7 @@
 #include <QtCore/QBasicTimer>
 #include <QtQuick/private/qquickrectangle_p.h>
 
+#include <UbuntuToolkit/private/indexranges_p.h>
 #include <UbuntuToolkit/private/uclistitemstyle_p.h>
 #include <UbuntuToolkit/private/ucstyleditembase_p_p.h>
 
@@ -156,6 +157,7 @@ public:
     bool addSelectedItem(UCListItem *item);
     bool removeSelectedItem(UCListItem *item);
     bool isItemSelected(UCListItem *item);
+    int itemCount() const;
     void enterDragMode();
     void leaveDragMode();
     bool isDragUpdatedConnected();
@@ -167,7 +169,7 @@ public:
     void collapseAll();
     void toggleExpansionFlags(bool enable);
 
-    QSet<int> selectedList;
+    IndexRanges selectedList;
     QMap<int, QPointer<UCListItem> > expansionList;
     QList< QPointer<QQuickFlickable> > flickables;
     QPointer<UCListItem> boundItem;
@@ -18,9 +18,13 @@
 
 #include "ucqquickimageextension_p.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
 #include <QtGui/QGuiApplication>
 #include <QtQuick/private/qquickitem_p.h>
 #include <QtQuick/private/qquickimagebase_p.h>
@@ -34,7 +38,8 @@
 
 UT_NAMESPACE_BEGIN
 
-QHash<QUrl, QSharedPointer<QTemporaryFile> > UCQQuickImageExtension::s_rewrittenSciFiles;
+QHash<QString, QString> UCQQuickImageExtension::s_rewrittenSciFiles;
+QList<QSharedPointer<QTemporaryFile> > UCQQuickImageExtension::s_temporarySciFiles;
 
 /*!
     \internal
@@ -173,35 +178,17 @@ void UCQQuickImageExtension::reloadSource()
           // Regular image file
             m_image->setSource(QUrl("image://scaling/" + resolved + fragment));
         } else {
-            // .sci image file. Rewrite the .sci file into a temporary file.
-            bool rewritten = true;
-            QTemporaryFile* rewrittenSciFile;
-
-            /* Ensure that only one temporary rewritten .sci file is created
-               for each source .sci file by storing the path to the temporary
-               file in a global hash.
-            */
-            rewrittenSciFile = UCQQuickImageExtension::s_rewrittenSciFiles.value(m_source).data();
-            if (rewrittenSciFile == NULL) {
-                rewrittenSciFile = new QTemporaryFile;
-                rewrittenSciFile->setFileTemplate(QDir::tempPath() + "/XXXXXX.sci");
-                rewrittenSciFile->open();
-                QTextStream output(rewrittenSciFile);
-
-                if (qFuzzyCompare(qGuiApp->devicePixelRatio(), (qreal)1.0)) {
-                    rewritten = rewriteSciFile(selectedFilePath, scaleFactor, output);
-                } else {
-                    QString scaleFactorInDevicePixels = QString::number(scaleFactor.toFloat() / qGuiApp->devicePixelRatio());
-                    rewritten = rewriteSciFile(selectedFilePath, scaleFactorInDevicePixels, output);
-                }
-                rewrittenSciFile->close();
-
-                s_rewrittenSciFiles.insert(m_source, QSharedPointer<QTemporaryFile>(rewrittenSciFile));
+            // .sci image file. Rewrite the .sci file with scaled borders.
+            QString effectiveScaleFactor = scaleFactor;
+            if (!qFuzzyCompare(qGuiApp->devicePixelRatio(), (qreal)1.0)) {
+                effectiveScaleFactor = QString::number(scaleFactor.toFloat() / qGuiApp->devicePixelRatio());
             }
+            const QString rewrittenSciFilePath = rewrittenSciFile(selectedFilePath, effectiveScaleFactor);
+            const bool rewritten = !rewrittenSciFilePath.isEmpty();
 
             if (rewritten) {
                 // Take care to pass the original fragment
-                QUrl rewrittenSciFileUrl(QUrl::fromLocalFile(rewrittenSciFile->fileName()));
+                QUrl rewrittenSciFileUrl(QUrl::fromLocalFile(rewrittenSciFilePath));
                 rewrittenSciFileUrl.setFragment(fragment);
                 m_image->setSource(rewrittenSciFileUrl);
             } else {
@@ -214,6 +201,102 @@ void UCQQuickImageExtension::reloadSource()
     }
 }
 
+/* Returns the path of the .sci file rewritten for the scale factor, or an empty string if
+   the .sci file cannot be read. Rewritten files are kept in the user cache directory under
+   a name made of the hashed .sci file path, its modification time and the scale factor, so
+   they are shared by all the processes and reused across runs. Rewriting a .sci file removes
+   the files rewritten for its former modification times. Within a process each .sci file is
+   looked up once per scale factor.
+*/
+QString UCQQuickImageExtension::rewrittenSciFile(const QString &sciFilePath, const QString &scaleFactor)
+{
+    const QString key = sciFilePath + QLatin1Char('\n') + scaleFactor;
+    QHash<QString, QString>::const_iterator cached = s_rewrittenSciFiles.constFind(key);
+    if (cached != s_rewrittenSciFiles.constEnd()) {
+        return cached.value();
+    }
+
+    const QFileInfo sciFile(sciFilePath);
+    if (!sciFile.isFile()) {
+        return QString();
+    }
+    // the rewritten sources refer to the .sci file directory as given
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sciFilePath.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(sciFile.absoluteFilePath().toUtf8());
+    const QString sourcePrefix = QString::fromLatin1(hash.result().toHex()) + QLatin1Char('-');
+    const QString versionPrefix = sourcePrefix
+        + QString::number(sciFile.lastModified().toMSecsSinceEpoch()) + QLatin1Char('-');
+    const QString fileName = sciCacheDirectory() + versionPrefix
+        + QString::fromLatin1(scaleFactor.toUtf8().toHex()) + ".sci";
+
+    QString rewrittenFileName;
+    if (QFile::exists(fileName)) {
+        rewrittenFileName = fileName;
+    } else {
+        // written under a temporary name and renamed, as other processes may use it
+        QSaveFile cacheFile(fileName);
+        if (cacheFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream output(&cacheFile);
+            if (!rewriteSciFile(sciFilePath, scaleFactor, output)) {
+                cacheFile.cancelWriting();
+                return QString();
+            }
+            output.flush();
+            if (cacheFile.commit()) {
+                rewrittenFileName = fileName;
+                pruneSciCache(sourcePrefix, versionPrefix);
+            }
+        }
+    }
+
+    if (rewrittenFileName.isEmpty()) {
+        // no usable cache directory, rewrite into a file living as long as the process
+        QSharedPointer<QTemporaryFile> temporaryFile(new QTemporaryFile);
+        temporaryFile->setFileTemplate(QDir::tempPath() + "/XXXXXX.sci");
+        if (!temporaryFile->open()) {
+            return QString();
+        }
+        QTextStream output(temporaryFile.data());
+        if (!rewriteSciFile(sciFilePath, scaleFactor, output)) {
+            return QString();
+        }
+        temporaryFile->close();
+        s_temporarySciFiles.append(temporaryFile);
+        rewrittenFileName = temporaryFile->fileName();
+    }
+
+    s_rewrittenSciFiles.insert(key, rewrittenFileName);
+    return rewrittenFileName;
+}
+
+// returns the directory of the rewritten .sci files, with a trailing slash
+QString UCQQuickImageExtension::sciCacheDirectory()
+{
+    static QString path;
+    if (path.isEmpty()) {
+        path = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+            + QStringLiteral("/ubuntu-ui-toolkit/sci/");
+        QDir().mkpath(path);
+    }
+    return path;
+}
+
+// removes the files rewritten from former versions of a .sci file, the other scale factors
+// of the current version may be in use by other processes
+void UCQQuickImageExtension::pruneSciCache(const QString &sourcePrefix, const QString &versionPrefix)
+{
+    QDir cacheDir(sciCacheDirectory());
+    const QStringList entries =
+        cacheDir.entryList(QStringList(sourcePrefix + QStringLiteral("*.sci")), QDir::Files);
+    Q_FOREACH(const QString &entry, entries) {
+        if (!entry.startsWith(versionPrefix)) {
+            cacheDir.remove(entry);
+        }
+    }
+}
+
 bool UCQQuickImageExtension::rewriteSciFile(const QString &sciFilePath, const QString &scaleFactor, QTextStream& output)
 {
     QFile sciFile(sciFilePath);
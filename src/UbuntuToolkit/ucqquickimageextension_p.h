@@ -52,14 +52,20 @@ protected Q_SLOTS:
     void onSourceSizeChanged();
 
 protected:
-    bool rewriteSciFile(const QString &sciFilePath, const QString &scaleFactor, QTextStream& output);
-    QString scaledBorder(const QString &border, const QString &scaleFactor);
-    QString scaledSource(QString source, const QString &sciFilePath, const QString &scaleFactor);
+    static QString rewrittenSciFile(const QString &sciFilePath, const QString &scaleFactor);
+    static QString sciCacheDirectory();
+    static void pruneSciCache(const QString &sourcePrefix, const QString &versionPrefix);
+    static bool rewriteSciFile(const QString &sciFilePath, const QString &scaleFactor, QTextStream& output);
+    static QString scaledBorder(const QString &border, const QString &scaleFactor);
+    static QString scaledSource(QString source, const QString &sciFilePath, const QString &scaleFactor);
 
 private:
     QQuickImageBase* m_image;
     QUrl m_source;
-    static QHash<QUrl, QSharedPointer<QTemporaryFile> > s_rewrittenSciFiles;
+    // .sci file path and scale factor -> rewritten .sci file path
+    static QHash<QString, QString> s_rewrittenSciFiles;
+    // rewritten files when the cache directory is not writable
+    static QList<QSharedPointer<QTemporaryFile> > s_temporarySciFiles;
 };
 
 UT_NAMESPACE_END
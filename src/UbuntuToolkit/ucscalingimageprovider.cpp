@@ -18,7 +18,11 @@
 
 #include "ucscalingimageprovider_p.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
 #include <QtGui/QImageReader>
 
 UT_NAMESPACE_BEGIN
@@ -33,9 +37,117 @@ UT_NAMESPACE_BEGIN
 
     Example:
      * image://scaling/0.5/arrow.png
+
+    Images are decoded on the provider's thread pool. The decoded images are kept in
+    a least recently used cache bounded by the decoded size, keyed by the path, the
+    scale, the requested size and the modification time of the file, so the same asset
+    requested by many delegates is only decoded once.
 */
-UCScalingImageProvider::UCScalingImageProvider() : QQuickImageProvider(QQuickImageProvider::Image)
+
+class ScalingImageResponse;
+
+// shared between a response and the runnable decoding its image, so that the response
+// can go away while the image is being decoded
+struct ScalingImageJob
+{
+    ScalingImageJob(ScalingImageResponse *response) : response(response), cancelled(false) {}
+
+    QMutex mutex;
+    ScalingImageResponse *response;
+    bool cancelled;
+};
+
+class ScalingImageResponse : public QQuickImageResponse
+{
+public:
+    ScalingImageResponse() : job(new ScalingImageJob(this)) {}
+    ~ScalingImageResponse()
+    {
+        QMutexLocker locker(&job->mutex);
+        job->response = Q_NULLPTR;
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        QMutexLocker locker(&job->mutex);
+        return QQuickTextureFactory::textureFactoryForImage(image);
+    }
+    void cancel() override
+    {
+        QMutexLocker locker(&job->mutex);
+        job->cancelled = true;
+    }
+
+    QSharedPointer<ScalingImageJob> job;
+    QImage image;
+};
+
+class ScalingImageRunnable : public QRunnable
+{
+public:
+    ScalingImageRunnable(UCScalingImageProvider *provider, ScalingImageResponse *response,
+                         const QString &id, const QSize &requestedSize)
+        : job(response->job), provider(provider), id(id), requestedSize(requestedSize)
+    {
+    }
+
+    // responses always emit finished(), with a null image when cancelled or when the
+    // provider goes away, so that the engine deletes them
+    void run() override
+    {
+        QImage image;
+        bool skipped;
+        {
+            QMutexLocker locker(&job->mutex);
+            skipped = job->cancelled || !job->response || provider->m_stopping.load();
+        }
+        if (!skipped) {
+            QSize size;
+            image = provider->requestImage(id, &size, requestedSize);
+        }
+
+        QMutexLocker locker(&job->mutex);
+        if (job->response) {
+            job->response->image = image;
+            Q_EMIT job->response->finished();
+        }
+    }
+
+private:
+    QSharedPointer<ScalingImageJob> job;
+    UCScalingImageProvider *provider;
+    QString id;
+    QSize requestedSize;
+};
+
+uint qHash(const UCScalingImageProvider::CacheKey &key, uint seed)
+{
+    return qHash(key.path, seed) ^ qHash(key.scaleFactor, seed)
+        ^ qHash(qMakePair(key.requestedSize.width(), key.requestedSize.height()), seed)
+        ^ qHash(key.lastModified, seed);
+}
+
+UCScalingImageProvider::UCScalingImageProvider()
+    : QQuickAsyncImageProvider()
+    , m_cache(defaultCacheSize)
+    , m_hits(0)
+    , m_misses(0)
+    , m_stopping(0)
+{
+}
+
+UCScalingImageProvider::~UCScalingImageProvider()
 {
+    // the queued jobs finish their responses without decoding
+    m_stopping.store(1);
+    m_pool.waitForDone();
+}
+
+QQuickImageResponse *UCScalingImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    ScalingImageResponse *response = new ScalingImageResponse;
+    m_pool.start(new ScalingImageRunnable(this, response, id, requestedSize));
+    return response;
 }
 
 QImage UCScalingImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
@@ -45,8 +157,38 @@ QImage UCScalingImageProvider::requestImage(const QString &id, QSize *size, cons
     int fragmentPosition = id.lastIndexOf(QStringLiteral("#"));
     int pathLength = fragmentPosition > -1 ? fragmentPosition - separatorPosition - 1 : -1;
     QString path = id.mid(separatorPosition + 1, pathLength);
-    QFile file(path);
 
+    const QFileInfo info(path);
+    if (!info.exists()) {
+        return QImage();
+    }
+    const CacheKey key = { path, scaleFactor, requestedSize, info.lastModified().toMSecsSinceEpoch() };
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        CachedImage *cached = m_cache.object(key);
+        if (cached) {
+            m_hits++;
+            *size = cached->size;
+            return cached->image;
+        }
+        m_misses++;
+    }
+
+    QImage image = loadImage(path, scaleFactor, size, requestedSize);
+    if (!image.isNull()) {
+        CachedImage *cached = new CachedImage;
+        cached->image = image;
+        cached->size = *size;
+        QMutexLocker locker(&m_cacheMutex);
+        // images bigger than the cache are not kept
+        m_cache.insert(key, cached, image.bytesPerLine() * image.height());
+    }
+    return image;
+}
+
+QImage UCScalingImageProvider::loadImage(const QString &path, float scaleFactor, QSize *size, const QSize &requestedSize)
+{
+    QFile file(path);
     if (file.open(QIODevice::ReadOnly)) {
         QImage image;
         QImageReader imageReader(&file);
@@ -83,4 +225,30 @@ QImage UCScalingImageProvider::requestImage(const QString &id, QSize *size, cons
     }
 }
 
+// sets the maximum number of decoded bytes kept
+void UCScalingImageProvider::setCacheSize(int bytes)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_cache.setMaxCost(bytes);
+}
+
+int UCScalingImageProvider::cacheSize() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_cache.maxCost();
+}
+
+UCScalingImageProvider::Statistics UCScalingImageProvider::statistics() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    Statistics statistics = { m_hits, m_misses, m_cache.totalCost(), m_cache.count() };
+    return statistics;
+}
+
+void UCScalingImageProvider::clearCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_cache.clear();
+}
+
 UT_NAMESPACE_END
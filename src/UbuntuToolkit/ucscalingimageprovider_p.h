@@ -19,6 +19,10 @@
 #ifndef UCSCALINGIMAGEPROVIDER_P_H
 #define UCSCALINGIMAGEPROVIDER_P_H
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
 #include <QtGui/QImage>
 #include <QtQuick/QQuickImageProvider>
 
@@ -26,11 +30,59 @@
 
 UT_NAMESPACE_BEGIN
 
-class UBUNTUTOOLKIT_EXPORT UCScalingImageProvider : public QQuickImageProvider
+class UBUNTUTOOLKIT_EXPORT UCScalingImageProvider : public QQuickAsyncImageProvider
 {
 public:
+    struct Statistics {
+        quint64 hits;
+        quint64 misses;
+        // decoded bytes held by the cache
+        int bytes;
+        int count;
+    };
+
     explicit UCScalingImageProvider();
+    ~UCScalingImageProvider();
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+    // synchronous loading, used by the asynchronous responses; thread safe
     QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+
+    void setCacheSize(int bytes);
+    int cacheSize() const;
+    Statistics statistics() const;
+    void clearCache();
+
+    static const int defaultCacheSize = 8 * 1024 * 1024;
+
+private:
+    struct CacheKey {
+        QString path;
+        float scaleFactor;
+        QSize requestedSize;
+        qint64 lastModified;
+
+        bool operator==(const CacheKey &other) const
+        {
+            return path == other.path && scaleFactor == other.scaleFactor
+                && requestedSize == other.requestedSize && lastModified == other.lastModified;
+        }
+    };
+    struct CachedImage {
+        QImage image;
+        QSize size;
+    };
+    friend uint qHash(const CacheKey &key, uint seed);
+
+    QImage loadImage(const QString &path, float scaleFactor, QSize *size, const QSize &requestedSize);
+
+    mutable QMutex m_cacheMutex;
+    QCache<CacheKey, CachedImage> m_cache;
+    quint64 m_hits;
+    quint64 m_misses;
+    QAtomicInt m_stopping;
+    QThreadPool m_pool;
+
+    friend class ScalingImageRunnable;
 };
 
 UT_NAMESPACE_END
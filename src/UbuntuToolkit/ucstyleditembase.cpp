@@ -19,6 +19,7 @@
 #include "ucstyleditembase_p_p.h"
 
 #include <QtQml/QQmlEngine>
+#include <QtQml/QQmlInfo>
 #include <QtQuick/private/qquickanchors_p.h>
 
 #include "ucstylehints_p.h"
@@ -27,15 +28,22 @@
 
 UT_NAMESPACE_BEGIN
 
+// style instances are incubated when UBUNTU_UI_TOOLKIT_ASYNC_STYLES is set to 1
+bool UCStyledItemBasePrivate::asynchronousStyleDefault =
+    qgetenv("UBUNTU_UI_TOOLKIT_ASYNC_STYLES") == "1";
+
 UCStyledItemBasePrivate::UCStyledItemBasePrivate()
     : oldParentItem(Q_NULLPTR)
     , styleComponent(Q_NULLPTR)
     , styleItem(Q_NULLPTR)
+    , styleIncubator(Q_NULLPTR)
     , styleVersion(0)
     , keyNavigationFocus(false)
     , activeFocusOnPress(false)
     , wasStyleLoaded(false)
     , isFocusScope(true)
+    , asynchronousStyleLoading(asynchronousStyleDefault)
+    , asynchronousStyleSupported(true)
 {
 }
 
@@ -94,6 +102,7 @@ void UCStyledItemBase::setActiveFocusOnTab2(bool v)
 
 UCStyledItemBasePrivate::~UCStyledItemBasePrivate()
 {
+    cancelStyleIncubation();
 }
 
 void UCStyledItemBasePrivate::init()
@@ -339,10 +348,35 @@ void UCStyledItemBasePrivate::setStyleName(const QString &name)
     loadStyleItem();
 }
 
+/*!
+ * \qmlproperty bool StyledItem::asynchronousStyle
+ * \since Ubuntu.Components 1.3
+ * When set, the style instance is created asynchronously on the engine's incubation
+ * controller instead of blocking the creation of the item. Until the style is ready the
+ * item has no visuals and \c __styleInstance is null; \c styleInstanceChanged is emitted
+ * once the style is created. The default value is false, and can be turned on for all
+ * the items by setting the \c UBUNTU_UI_TOOLKIT_ASYNC_STYLES environment variable to 1.
+ * Changing the property only affects the next style loading.
+ * \note Some components need their style right away and always load it synchronously.
+ */
+bool UCStyledItemBasePrivate::asynchronousStyle() const
+{
+    return asynchronousStyleLoading;
+}
+void UCStyledItemBasePrivate::setAsynchronousStyle(bool asynchronous)
+{
+    if (asynchronousStyleLoading == asynchronous) {
+        return;
+    }
+    asynchronousStyleLoading = asynchronous;
+    Q_EMIT q_func()->asynchronousStyleChanged();
+}
+
 // performs pre-style change actions, removes style item size change
 // connections and destroys the style component
 void UCStyledItemBasePrivate::preStyleChanged()
 {
+    cancelStyleIncubation();
     if (styleItem) {
         // make sure the context holder is reset too
         styleItemContext.clear();
@@ -357,10 +391,14 @@ void UCStyledItemBasePrivate::preStyleChanged()
 }
 
 // loads the style animated or not, depending on the loading time
-// returns true on successful style loading
+// returns true on successful style loading, or when the style is being incubated
 bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
 {
-    if (styleItem || (!styleComponent && styleDocument.isEmpty()) || !componentComplete) {
+    if (styleIncubator && !styleIncubator->isLoading()) {
+        // the previous incubation failed
+        cancelStyleIncubation();
+    }
+    if (styleItem || styleIncubator || (!styleComponent && styleDocument.isEmpty()) || !componentComplete) {
         // the style loading is delayed
         return false;
     }
@@ -369,11 +407,16 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
     QQmlComponent *component = styleComponent;
     UCTheme *theme = q->getTheme();
     if (!component && theme) {
-        component = theme->createStyleComponent(styleDocument + ".qml", q, styleVersion);
+        // shared by all the items of the theme, must be released once the style is created
+        component = theme->acquireStyleComponent(styleDocument + ".qml", q, styleVersion);
     }
     if (!component) {
         return false;
     }
+    if (styleComponent) {
+        // not owned by the theme
+        theme = Q_NULLPTR;
+    }
     // create context
     // use creation context as parent to create the context we load the style item with
     QQmlContext *creationContext = component->creationContext();
@@ -382,19 +425,49 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
     }
     if (creationContext && !creationContext->isValid()) {
         // we are having the changes in the component being under deletion
+        if (theme) {
+            theme->releaseStyleComponent(component);
+        }
         return false;
     }
     styleItemContext = new QQmlContext(creationContext);
     styleItemContext->setContextObject(q);
     styleItemContext->setContextProperty(QStringLiteral("styledItem"), q);
     styleItemContext->setContextProperty(QStringLiteral("animated"), animated);
+
+    QQmlEngine *engine = qmlEngine(q);
+    if (asynchronousStyleLoading && asynchronousStyleSupported && engine
+            && engine->incubationController()) {
+        // the style item is attached to the item once the incubator is ready
+        styleIncubator = new StyleIncubator(this, component, theme, animated);
+        component->create(*styleIncubator, styleItemContext);
+        return true;
+    }
+
     QObject *object = component->beginCreate(styleItemContext);
     if (!object) {
         delete styleItemContext;
+        if (theme) {
+            theme->releaseStyleComponent(component);
+        }
         return false;
     }
     // link context to the style item to delete them together
     QQml_setParent_noEvent(styleItemContext, object);
+    attachStyleItem(object);
+    component->completeCreate();
+    // release the theme's component
+    if (theme) {
+        theme->releaseStyleComponent(component);
+    }
+    styleItemLoaded(animated);
+    return true;
+}
+
+// parents the created style item to the styled item
+void UCStyledItemBasePrivate::attachStyleItem(QObject *object)
+{
+    Q_Q(UCStyledItemBase);
     styleItem = qobject_cast<::QQuickItem*>(object);
     if (styleItem) {
         QQml_setParent_noEvent(styleItem, q);
@@ -407,28 +480,85 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
     } else {
         delete object;
     }
-    component->completeCreate();
-    // delete temporary component
-    if (!styleComponent) {
-        delete component;
-    }
+}
 
+// finalizes the style item creation
+void UCStyledItemBasePrivate::styleItemLoaded(bool animated)
+{
     // make sure we reset the animated property to true
-    if (!animated) {
+    if (!animated && styleItemContext) {
         styleItemContext->setContextProperty(QStringLiteral("animated"), true);
     }
 
     // set implicit size
     _q_styleResized();
     connectStyleSizeChanges(true);
-    Q_EMIT q->styleInstanceChanged();
-    return true;
+    Q_EMIT q_func()->styleInstanceChanged();
+}
+
+// aborts the style incubation in progress, and drops the finished incubator
+void UCStyledItemBasePrivate::cancelStyleIncubation()
+{
+    if (!styleIncubator) {
+        return;
+    }
+    StyleIncubator *incubator = styleIncubator;
+    styleIncubator = Q_NULLPTR;
+    bool contextAdopted = incubator->contextAdopted;
+    // deletes the style object if that is not complete yet
+    delete incubator;
+    if (!contextAdopted) {
+        delete styleItemContext.data();
+    }
+}
+
+StyleIncubator::StyleIncubator(UCStyledItemBasePrivate *styledItem, QQmlComponent *component,
+                               UCTheme *theme, bool animated)
+    : QQmlIncubator(Asynchronous)
+    , animated(animated)
+    , contextAdopted(false)
+    , styledItem(styledItem)
+    , component(component)
+    , theme(theme)
+{
+}
+
+StyleIncubator::~StyleIncubator()
+{
+    clear();
+    releaseComponent();
+}
+
+void StyleIncubator::releaseComponent()
+{
+    if (theme) {
+        theme->releaseStyleComponent(component);
+        theme.clear();
+    }
+}
+
+void StyleIncubator::setInitialState(QObject *object)
+{
+    // link context to the style item to delete them together
+    QQml_setParent_noEvent(styledItem->styleItemContext, object);
+    contextAdopted = true;
+}
+
+void StyleIncubator::statusChanged(Status status)
+{
+    if (status == Loading || status == Null) {
+        return;
+    }
+    // the incubator itself is deleted on the next style change
+    releaseComponent();
+    if (status == Ready) {
+        styledItem->attachStyleItem(object());
+        styledItem->styleItemLoaded(animated);
+    } else {
+        qmlWarning(styledItem->q_func(), errors());
+    }
 }
 
-/*!
- * \internal
- * Instance of the \l style.
- */
 QQuickItem *UCStyledItemBasePrivate::styleInstance()
 {
     return styleItem;
@@ -506,7 +636,7 @@ void UCStyledItemBasePrivate::_q_styleResized()
 void UCStyledItemBase::preThemeChanged()
 {
     Q_D(UCStyledItemBase);
-    d->wasStyleLoaded = (d->styleItem != Q_NULLPTR);
+    d->wasStyleLoaded = (d->styleItem != Q_NULLPTR) || (d->styleIncubator != Q_NULLPTR);
     d->preStyleChanged();
 }
 void UCStyledItemBase::postThemeChanged()
@@ -49,6 +49,7 @@ class UBUNTUTOOLKIT_EXPORT UCStyledItemBase : public QQuickItem, public UCThemin
     Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), QQuickItem *__styleInstance READ styleInstance NOTIFY styleInstanceChanged FINAL DESIGNABLE false)
     Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), QString styleName READ styleName WRITE setStyleName NOTIFY styleNameChanged FINAL REVISION 2)
     Q_PROPERTY(UT_PREPEND_NAMESPACE(UCTheme) *theme READ getTheme WRITE setTheme RESET resetTheme NOTIFY themeChanged FINAL REVISION 2)
+    Q_PRIVATE_PROPERTY(UCStyledItemBase::d_func(), bool asynchronousStyle READ asynchronousStyle WRITE setAsynchronousStyle NOTIFY asynchronousStyleChanged FINAL REVISION 2)
 public:
     explicit UCStyledItemBase(QQuickItem *parent = 0);
 
@@ -69,6 +70,7 @@ Q_SIGNALS:
     Q_REVISION(1) void activeFocusOnTabChanged2();
     Q_REVISION(2) void themeChanged();
     Q_REVISION(2) void styleNameChanged();
+    Q_REVISION(2) void asynchronousStyleChanged();
 
 protected:
     UCStyledItemBase(UCStyledItemBasePrivate &, QQuickItem *parent);
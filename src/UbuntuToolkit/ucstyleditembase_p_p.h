@@ -21,6 +21,7 @@
 
 #include <UbuntuToolkit/private/ucstyleditembase_p.h>
 
+#include <QtQml/QQmlIncubator>
 #include <QtQuick/private/qquickitem_p.h>
 
 #include <UbuntuToolkit/private/ucthemingextension_p.h>
@@ -31,10 +32,37 @@ class QQuickMouseArea;
 UT_NAMESPACE_BEGIN
 
 class UCStyledItemBase;
+class UCStyledItemBasePrivate;
+class UCTheme;
+
+// creates the style instance of a styled item on the engine's incubation controller
+class StyleIncubator : public QQmlIncubator
+{
+public:
+    StyleIncubator(UCStyledItemBasePrivate *styledItem, QQmlComponent *component, UCTheme *theme,
+                   bool animated);
+    ~StyleIncubator();
+    void releaseComponent();
+
+    bool animated:1;
+    bool contextAdopted:1;
+
+protected:
+    void setInitialState(QObject *object) override;
+    void statusChanged(Status status) override;
+
+private:
+    UCStyledItemBasePrivate *styledItem;
+    QQmlComponent *component;
+    // set when the component is shared by the theme
+    QPointer<UCTheme> theme;
+};
+
 class UBUNTUTOOLKIT_EXPORT UCStyledItemBasePrivate : public QQuickItemPrivate, public UCImportVersionChecker
 {
     Q_INTERFACES(UT_PREPEND_NAMESPACE(UCThemingExtension))
     Q_DECLARE_PUBLIC(UCStyledItemBase)
+    friend class StyleIncubator;
 public:
 
     static UCStyledItemBasePrivate *get(UCStyledItemBase *item) {
@@ -57,11 +85,16 @@ public:
 
     QString styleName() const;
     void setStyleName(const QString &name);
+    bool asynchronousStyle() const;
+    void setAsynchronousStyle(bool asynchronous);
 
     virtual void preStyleChanged();
     virtual void postStyleChanged() {}
     virtual bool loadStyleItem(bool animated = true);
     virtual void completeComponentInitialization();
+    void attachStyleItem(QObject *object);
+    void styleItemLoaded(bool animated);
+    void cancelStyleIncubation();
 
     // from UCImportVersionChecker
     QString propertyForVersion(quint16 version) const override;
@@ -73,11 +106,17 @@ public:
     QQuickItem *oldParentItem;
     QQmlComponent *styleComponent;
     QQuickItem *styleItem;
+    StyleIncubator *styleIncubator;
     quint16 styleVersion;
     bool keyNavigationFocus:1;
     bool activeFocusOnPress:1;
     bool wasStyleLoaded:1;
     bool isFocusScope:1;
+    bool asynchronousStyleLoading:1;
+    // cleared by the items which need the style instance right after loadStyleItem()
+    bool asynchronousStyleSupported:1;
+
+    static bool asynchronousStyleDefault;
 
 protected:
 
@@ -20,6 +20,7 @@
 #include "uctheme_p.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QStandardPaths>
@@ -198,7 +199,61 @@ QStringList themeSearchPath()
     return result;
 }
 
-UCTheme::ThemeRecord pathFromThemeName(QString themeName)
+/*
+ * Builds the index of the style files of a theme folder, once per folder as long as the
+ * folderIndexes cache is kept. Only the theme folder itself and its immediate subfolders
+ * (the versioned style folders) are listed, as those are the only places styleUrl() looks
+ * at. Setting UBUNTU_UI_TOOLKIT_THEMES_INDEX to 0 disables the index, styles are then
+ * looked up with a stat() per candidate.
+ */
+static bool indexThemeFolder(const QString &themeFolder, QSet<QString> *index,
+                             UCTheme::FolderIndexes *folderIndexes)
+{
+    static const bool indexEnabled = qgetenv("UBUNTU_UI_TOOLKIT_THEMES_INDEX") != "0";
+    if (!indexEnabled) {
+        return false;
+    }
+
+    if (folderIndexes) {
+        UCTheme::FolderIndexes::const_iterator cached = folderIndexes->constFind(themeFolder);
+        if (cached != folderIndexes->constEnd()) {
+            *index = cached.value();
+            return true;
+        }
+    }
+
+    QDirIterator folder(themeFolder, QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
+    while (folder.hasNext()) {
+        folder.next();
+        const QFileInfo info = folder.fileInfo();
+        if (!info.isDir()) {
+            index->insert(info.fileName());
+            continue;
+        }
+        const QString prefix = info.fileName() + '/';
+        QDirIterator subFolder(info.filePath(), QDir::Files);
+        while (subFolder.hasNext()) {
+            subFolder.next();
+            index->insert(prefix + subFolder.fileName());
+        }
+    }
+    if (folderIndexes) {
+        folderIndexes->insert(themeFolder, *index);
+    }
+    return true;
+}
+
+bool UCTheme::ThemeRecord::contains(const QString &fileName) const
+{
+    // the index only covers two levels, deeper or relative names go to the file system
+    if (indexed && fileName.count('/') <= 1 && !fileName.startsWith('.')) {
+        return index.contains(fileName);
+    }
+    const QUrl url = path.resolved(fileName);
+    return url.isValid() && QFile::exists(url.toLocalFile());
+}
+
+UCTheme::ThemeRecord pathFromThemeName(QString themeName, UCTheme::FolderIndexes *folderIndexes)
 {
     // the first entry from pathList is the app's current folder
     UCTheme::ThemeRecord record(themeName, QUrl(), false, false);
@@ -212,6 +267,7 @@ UCTheme::ThemeRecord pathFromThemeName(QString themeName)
             record.deprecated = QFile::exists(absoluteThemeFolder + "deprecated");
             record.shared = QFile::exists(absoluteThemeFolder + "qmldir");
             record.path = QUrl::fromLocalFile(absoluteThemeFolder);
+            record.indexed = indexThemeFolder(absoluteThemeFolder, &record.index, folderIndexes);
             break;
         }
     }
@@ -472,10 +528,13 @@ void UCTheme::_q_defaultThemeChanged()
 void UCTheme::updateThemePaths()
 {
     m_themePaths.clear();
+    m_styleUrlCache.clear();
+    m_folderIndexes.clear();
+    evictStyleComponents();
 
     QString themeName = name();
     while (!themeName.isEmpty()) {
-        ThemeRecord themePath = pathFromThemeName(themeName);
+        ThemeRecord themePath = pathFromThemeName(themeName, &m_folderIndexes);
         if (themePath.isValid()) {
             m_themePaths.append(themePath);
         }
@@ -500,6 +559,9 @@ void UCTheme::setParentTheme(UCTheme *parentTheme)
     }
     Q_ASSERT(parentTheme);
     m_parentTheme = parentTheme;
+    m_styleUrlCache.clear();
+    m_folderIndexes.clear();
+    evictStyleComponents();
     Q_EMIT parentThemeChanged();
 }
 
@@ -636,9 +698,23 @@ void UCTheme::resetPalette()
 
 QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallback)
 {
+    const QPair<QString, quint16> key(styleName, version);
+    QHash<QPair<QString, quint16>, StyleUrlCacheEntry>::const_iterator cached =
+        m_styleUrlCache.constFind(key);
+    if (cached == m_styleUrlCache.constEnd()) {
+        StyleUrlCacheEntry entry;
+        entry.url = resolveStyleUrl(styleName, version, &entry.fallback);
+        cached = m_styleUrlCache.insert(key, entry);
+    }
     if (isFallback) {
-        (*isFallback) = false;
+        (*isFallback) = cached->fallback;
     }
+    return cached->url;
+}
+
+QUrl UCTheme::resolveStyleUrl(const QString& styleName, quint16 version, bool *isFallback)
+{
+    (*isFallback) = false;
 
     // loop through the versions first, so we will look after the style in all
     // the parents, then fall back to the older version
@@ -648,7 +724,6 @@ QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallba
     for (int minor = MINOR_VERSION(version); minor >= 2; minor--) {
         // check with each path of the theme
         Q_FOREACH (const ThemeRecord &themePath, m_themePaths) {
-            QUrl styleUrl;
             /*
              * There are two cases where we have to deal with non-versioned styles: application
              * themes made for the previous theming and deprecated themes. For shared themes,
@@ -663,21 +738,17 @@ QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallba
             }
 
             QString versionedName = QStringLiteral("%1.%2/%3").arg(major).arg(minor).arg(styleName);
-            styleUrl = themePath.path.resolved(versionedName);
-            if (styleUrl.isValid() && QFile::exists(styleUrl.toLocalFile())) {
+            if (themePath.contains(versionedName)) {
                 // set fallback warning if the theme is shared
-                if (isFallback && themePath.shared && (version != styleVersion)) {
+                if (themePath.shared && (version != styleVersion)) {
                     (*isFallback) = true;
                 }
-                return styleUrl;
+                return themePath.path.resolved(versionedName);
             }
 
             // if we don't get any style, get the non-versioned ones for non-shared and deprecated styles
-            if (!themePath.shared || themePath.deprecated) {
-                styleUrl = themePath.path.resolved(styleName);
-                if (styleUrl.isValid() && QFile::exists(styleUrl.toLocalFile())) {
-                    return styleUrl;
-                }
+            if ((!themePath.shared || themePath.deprecated) && themePath.contains(styleName)) {
+                return themePath.path.resolved(styleName);
             }
         }
     }
@@ -758,33 +829,106 @@ QQmlComponent* UCTheme::createStyleComponent(const QString& styleName, QObject*
             // so for now we return NULL
             return Q_NULLPTR;
         }
-        // make sure we have the paths
-        bool fallback = false;
-        QUrl url = styleUrl(styleName, version, &fallback);
-        if (url.isValid()) {
-            if (fallback) {
-                qmlWarning(parent) << QStringLiteral("Theme '%1' has no '%2' style for version %3.%4, fall back to version %5.%6.")
-                                   .arg(name()).arg(styleName).arg(MAJOR_VERSION(version)).arg(MINOR_VERSION(version))
-                                   .arg(MAJOR_VERSION(LATEST_UITK_VERSION)).arg(MINOR_VERSION(LATEST_UITK_VERSION));
-            }
-            component = new QQmlComponent(engine, url, QQmlComponent::PreferSynchronous, parent);
-            if (component->isError()) {
-                qmlWarning(parent) << component->errorString();
-                delete component;
-                component = NULL;
-            } else {
-                // set context for the component
-                QQmlEngine::setContextForObject(component, qmlContext(parent));
-            }
-        } else {
-            qmlWarning(parent) <<
-               QStringLiteral("Warning: Style %1 not found in theme %2").arg(styleName).arg(name());
+        component = newStyleComponent(engine, styleName, parent, version, parent);
+        if (component) {
+            // set context for the component
+            QQmlEngine::setContextForObject(component, qmlContext(parent));
         }
     }
 
     return component;
 }
 
+// resolves the style and compiles its component, warns on the item on failure
+QQmlComponent* UCTheme::newStyleComponent(QQmlEngine *engine, const QString& styleName, QObject *item,
+                                          quint16 version, QObject *parent)
+{
+    // make sure we have the paths
+    bool fallback = false;
+    QUrl url = styleUrl(styleName, version, &fallback);
+    if (!url.isValid()) {
+        qmlWarning(item) <<
+           QStringLiteral("Warning: Style %1 not found in theme %2").arg(styleName).arg(name());
+        return Q_NULLPTR;
+    }
+    if (fallback) {
+        qmlWarning(item) << QStringLiteral("Theme '%1' has no '%2' style for version %3.%4, fall back to version %5.%6.")
+                           .arg(name()).arg(styleName).arg(MAJOR_VERSION(version)).arg(MINOR_VERSION(version))
+                           .arg(MAJOR_VERSION(LATEST_UITK_VERSION)).arg(MINOR_VERSION(LATEST_UITK_VERSION));
+    }
+    QQmlComponent *component = new QQmlComponent(engine, url, QQmlComponent::PreferSynchronous, parent);
+    if (component->isError()) {
+        qmlWarning(item) << component->errorString();
+        delete component;
+        component = NULL;
+    }
+    return component;
+}
+
+/*
+ * Returns the compiled style component for the style name and version, compiling it on the
+ * first request. The component is shared by all the styled items using this theme and has
+ * no context, the caller creates the style instances in the context of the item. Items from
+ * an other engine than the theme's get a private component. Each acquired component must be
+ * released with releaseStyleComponent().
+ */
+QQmlComponent* UCTheme::acquireStyleComponent(const QString& styleName, QObject* item, quint16 version)
+{
+    Q_ASSERT(version);
+    QQmlEngine* engine = qmlEngine(item);
+    if (!engine) {
+        return Q_NULLPTR;
+    }
+
+    QQmlComponent *component = Q_NULLPTR;
+    if (engine == qmlEngine(this)) {
+        const QPair<QString, quint16> key(styleName, version);
+        component = m_styleComponents.value(key);
+        if (!component) {
+            component = newStyleComponent(engine, styleName, item, version, this);
+            if (!component) {
+                return Q_NULLPTR;
+            }
+            m_styleComponents.insert(key, component);
+        }
+    } else {
+        component = newStyleComponent(engine, styleName, item, version, this);
+        if (!component) {
+            return Q_NULLPTR;
+        }
+        // not shared, deleted on release
+        m_evictedStyleComponents.insert(component);
+    }
+    m_styleComponentRefs[component]++;
+    return component;
+}
+
+void UCTheme::releaseStyleComponent(QQmlComponent *component)
+{
+    QHash<QQmlComponent*, int>::iterator ref = m_styleComponentRefs.find(component);
+    if (ref == m_styleComponentRefs.end()) {
+        return;
+    }
+    if (--ref.value() == 0 && m_evictedStyleComponents.remove(component)) {
+        m_styleComponentRefs.erase(ref);
+        delete component;
+    }
+}
+
+// drops the shared style components, the ones still in use are deleted on their last release
+void UCTheme::evictStyleComponents()
+{
+    Q_FOREACH(QQmlComponent *component, m_styleComponents) {
+        if (m_styleComponentRefs.value(component) > 0) {
+            m_evictedStyleComponents.insert(component);
+        } else {
+            m_styleComponentRefs.remove(component);
+            delete component;
+        }
+    }
+    m_styleComponents.clear();
+}
+
 void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
 {
     if (!engine) {
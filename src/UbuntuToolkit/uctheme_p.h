@@ -21,7 +21,10 @@
 #define UCTHEME_P_H
 
 #include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QPair>
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
 #include <QtQml/QQmlComponent>
@@ -53,22 +56,30 @@ class UBUNTUTOOLKIT_EXPORT UCTheme : public QObject, public QQmlParserStatus
 public:
 
     static quint16 previousVersion;
+
+    // style files of the theme folders, per absolute folder path
+    typedef QHash<QString, QSet<QString> > FolderIndexes;
+
     struct ThemeRecord {
         ThemeRecord() :
-            shared(false), deprecated(false)
+            shared(false), deprecated(false), indexed(false)
         {}
         ThemeRecord(const QString &name, const QUrl &path, bool shared, bool deprecated) :
-            name(name), path(path), shared(shared), deprecated(deprecated)
+            name(name), path(path), shared(shared), deprecated(deprecated), indexed(false)
         {}
         bool isValid() const
         {
             return path.isValid();
         }
+        bool contains(const QString &fileName) const;
 
         QString name;
         QUrl path;
+        // files of the theme folder and its version subfolders, relative to path
+        QSet<QString> index;
         bool shared:1;
         bool deprecated:1;
+        bool indexed:1;
     };
 
     explicit UCTheme(QObject *parent = 0);
@@ -86,6 +97,9 @@ public:
 
     // internal, used by the deprecated Theme.createStyledComponent()
     QQmlComponent* createStyleComponent(const QString& styleName, QObject* parent, quint16 version = 0);
+    // internal, style components shared by the styled items using this theme
+    QQmlComponent* acquireStyleComponent(const QString& styleName, QObject* item, quint16 version);
+    void releaseStyleComponent(QQmlComponent *component);
     void attachItem(QQuickItem *item, bool attach);
 
     // helper functions
@@ -115,8 +129,12 @@ private:
     void updateEnginePaths(QQmlEngine *engine);
     void updateThemePaths();
     QUrl styleUrl(const QString& styleName, quint16 version, bool *isFallback = NULL);
+    QUrl resolveStyleUrl(const QString& styleName, quint16 version, bool *isFallback);
     void loadPalette(QQmlEngine *engine, bool notify = true);
     void updateThemedItems();
+    QQmlComponent* newStyleComponent(QQmlEngine *engine, const QString& styleName, QObject *item,
+                                     quint16 version, QObject *parent);
+    void evictStyleComponents();
 
     class PaletteConfig
     {
@@ -167,7 +185,21 @@ private:
         QList<Data> configList;
     };
 
+    struct StyleUrlCacheEntry {
+        QUrl url;
+        bool fallback;
+    };
+
     PaletteConfig m_config;
+    // style URLs resolved per (style name, version), cleared when the theme paths change
+    QHash<QPair<QString, quint16>, StyleUrlCacheEntry> m_styleUrlCache;
+    // theme folder indexes, cleared together with the style URLs
+    FolderIndexes m_folderIndexes;
+    // compiled style components per (style name, version) and the reference count of each
+    // component handed out; evicted components live until their last reference is released
+    QHash<QPair<QString, quint16>, QQmlComponent*> m_styleComponents;
+    QHash<QQmlComponent*, int> m_styleComponentRefs;
+    QSet<QQmlComponent*> m_evictedStyleComponents;
     QString m_name;
     QPointer<UCTheme> m_parentTheme;
     QPointer<QObject> m_palette; // the palette might be from the default style if the theme doesn't define palette
@@ -179,7 +211,7 @@ private:
     friend class UCDeprecatedTheme;
 };
 
-UCTheme::ThemeRecord pathFromThemeName(QString themeName);
+UCTheme::ThemeRecord pathFromThemeName(QString themeName, UCTheme::FolderIndexes *folderIndexes = NULL);
 
 UT_NAMESPACE_END
 
@@ -30,6 +30,7 @@
 #include <math.h>
 
 #include <QtCore/QPointer>
+#include <QtCore/QScopedArrayPointer>
 #include <QtGui/QGuiApplication>
 #include <QtQml/QQmlInfo>
 #include <QtQuick/private/qsgadaptationlayer_p.h>
@@ -54,9 +55,166 @@ const float radiusSizeOffset = 2.0f;
 // Factor by which the final fragment RGB color must be multiplied for the pressed aspect.
 const float pressedFactor = 0.85f;
 
+// --- Scene graph textures ---
+
+// Bit masks of the shape texture channels storing distances, the other channels store shadows.
+const quint8 shapeTextureDistanceChannels[shapeTextureCount] = { 0xc, 0x3 };
+
+// The mipmap levels aren't stored in the library (they used to weigh ~700 KB), they are created
+// from the distance field textures the first time they're needed. The base level is bilinearly
+// upsampled from the distance field with distances converted to anti-aliased masks (that's what
+// the distance field shaders do per fragment) and the other levels are box filtered down. The
+// loops are kept simple with no dependencies between texels so that they can be vectorized.
+void createShapeTextureMipmaps(int index, quint8* data)
+{
+    Q_ASSERT(index >= 0 && index < shapeTextureCount);
+    const quint8* distanceField = shapeTextureData[index];
+    const quint8 distanceChannels = shapeTextureDistanceChannels[index];
+    const int width = shapeTextureMipmapWidth;
+    const int height = shapeTextureMipmapHeight;
+    const float sx = static_cast<float>(shapeTextureWidth) / width;
+    const float sy = static_cast<float>(shapeTextureHeight) / height;
+
+    // Distances are stored in texels of the distance field texture scaled by 255 / width and by
+    // shapeTextureDistanceAA, then biased by 127.5. Get the factor to convert them back in texels
+    // of the base mipmap level.
+    const float distanceFactor = (width / static_cast<float>(shapeTextureWidth))
+        / ((shapeTextureDistanceAA * 255.0f) / shapeTextureWidth);
+
+    for (int y = 0; y < height; y++) {
+        const float fy = qBound(0.0f, (y + 0.5f) * sy - 0.5f, shapeTextureHeight - 1.0f);
+        const int y0 = static_cast<int>(fy);
+        const int y1 = qMin(y0 + 1, shapeTextureHeight - 1);
+        const float wy = fy - y0;
+        const quint8* row0 = &distanceField[y0 * shapeTextureWidth * 4];
+        const quint8* row1 = &distanceField[y1 * shapeTextureWidth * 4];
+        quint8* texel = &data[y * width * 4];
+
+        for (int x = 0; x < width; x++) {
+            const float fx = qBound(0.0f, (x + 0.5f) * sx - 0.5f, shapeTextureWidth - 1.0f);
+            const int x0 = static_cast<int>(fx);
+            const int x1 = qMin(x0 + 1, shapeTextureWidth - 1);
+            const float wx = fx - x0;
+
+            for (int c = 0; c < 4; c++) {
+                const float top = row0[x0 * 4 + c] + (row0[x1 * 4 + c] - row0[x0 * 4 + c]) * wx;
+                const float bottom = row1[x0 * 4 + c] + (row1[x1 * 4 + c] - row1[x0 * 4 + c]) * wx;
+                float value = top + (bottom - top) * wy;
+                if (distanceChannels & (1 << c)) {
+                    value = qBound(0.0f, (value - 127.5f) * distanceFactor + 0.5f, 1.0f) * 255.0f;
+                }
+                texel[x * 4 + c] = static_cast<quint8>(value + 0.5f);
+            }
+        }
+    }
+
+    const quint8* source = data;
+    quint8* destination = data + width * height * 4;
+    for (int level = 1; level < shapeTextureMipmapCount; level++) {
+        const int sourceWidth = width >> (level - 1);
+        const int levelWidth = width >> level;
+        const int levelHeight = height >> level;
+        for (int y = 0; y < levelHeight; y++) {
+            const quint8* row0 = &source[(2 * y) * sourceWidth * 4];
+            const quint8* row1 = &source[(2 * y + 1) * sourceWidth * 4];
+            quint8* texel = &destination[y * levelWidth * 4];
+            for (int i = 0; i < levelWidth * 4; i++) {
+                const int x = (i >> 2) * 8 + (i & 3);
+                texel[i] = (row0[x] + row0[x + 4] + row1[x] + row1[x + 4] + 2) >> 2;
+            }
+        }
+        source = destination;
+        destination += levelWidth * levelHeight * 4;
+    }
+    Q_ASSERT(destination == data + shapeTextureMipmapSize);
+}
+
+// Create and setup shape textures.
+static void createShapeTextures(QOpenGLContext* openglContext, quint32* ids)
+{
+    glGenTextures(shapeTextureCount, ids);
+
+    if (UCUbuntuShape::useDistanceFields(openglContext)) {
+        // Create distance field textures.
+        for (int i = 0; i < shapeTextureCount; i++) {
+            glBindTexture(GL_TEXTURE_2D, ids[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, shapeTextureWidth, shapeTextureHeight, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, shapeTextureData[i]);
+        }
+    } else {
+        // Create mipmap textures.
+        QScopedArrayPointer<quint8> mipmapData(new quint8[shapeTextureMipmapSize]);
+        for (int i = 0; i < shapeTextureCount; i++) {
+            createShapeTextureMipmaps(i, mipmapData.data());
+            glBindTexture(GL_TEXTURE_2D, ids[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            int offset = 0;
+            for (int j = 0; j < shapeTextureMipmapCount; j++) {
+                const int width = shapeTextureMipmapWidth >> j;
+                const int height = shapeTextureMipmapHeight >> j;
+                glTexImage2D(GL_TEXTURE_2D, j, GL_RGBA, width, height, 0, GL_RGBA,
+                             GL_UNSIGNED_BYTE, &mipmapData[offset]);
+                offset += width * height * 4;
+            }
+        }
+    }
+}
+
+class ShapeTextures {
+public:
+    ShapeTextures() : m_refCount(0) {}
+    quint32* ids() { return m_ids; }
+    quint32 ref() { Q_ASSERT(m_refCount < UINT_MAX); return ++m_refCount; }
+    quint32 unref() { Q_ASSERT(m_refCount > 0); return --m_refCount; }
+private:
+    quint32 m_refCount;
+    quint32 m_ids[shapeTextureCount];
+};
+
+// The set of shape textures is owned by the graphics contexts. It's referenced by the shaders,
+// which QtQuick creates once per render context and material type, so that the registry is only
+// accessed when a render context sets up or releases its shaders and never when shapes (and their
+// materials) are created or destroyed.
+static QHash<QOpenGLContext*, ShapeTextures> shapeTexturesHash;
+static QMutex shapeTexturesHashMutex;
+
+// Get or create the set of textures associated with the given context.
+static void refShapeTextures(QOpenGLContext* context, quint32* ids)
+{
+    QMutexLocker locker(&shapeTexturesHashMutex);
+    ShapeTextures& textures = shapeTexturesHash[context];
+    if (textures.ref() == 1) {
+        createShapeTextures(context, textures.ids());
+    }
+    memcpy(ids, textures.ids(), shapeTextureCount * sizeof(quint32));
+}
+
+// Release the set of textures associated with the given context. The textures are only deleted
+// explicitly if the context is current, they are released along with the context otherwise.
+static void unrefShapeTextures(QOpenGLContext* context)
+{
+    QMutexLocker locker(&shapeTexturesHashMutex);
+    auto it = shapeTexturesHash.find(context);
+    Q_ASSERT(it != shapeTexturesHash.end());
+    if (it.value().unref() == 0) {
+        if (QOpenGLContext::currentContext() == context) {
+            glDeleteTextures(shapeTextureCount, it.value().ids());
+        }
+        shapeTexturesHash.erase(it);
+    }
+}
+
 // --- Scene graph shader ---
 
 ShapeShader::ShapeShader() :
+    m_context(NULL),
     m_useDistanceFields(UCUbuntuShape::useDistanceFields(QOpenGLContext::currentContext()))
 {
     setShaderSourceFile(QOpenGLShader::Vertex, QStringLiteral(":/uc/shaders/shape.vert"));
@@ -65,11 +223,20 @@ ShapeShader::ShapeShader() :
                         QStringLiteral(":/uc/shaders/shape_mipmap.frag"));
 }
 
+ShapeShader::~ShapeShader()
+{
+    // QtQuick deletes the shaders of a render context when it's invalidated, with the associated
+    // graphics context still current.
+    if (m_context) {
+        unrefShapeTextures(m_context);
+    }
+}
+
 char const* const* ShapeShader::attributeNames() const
 {
     static char const* const attributes[] = {
         "positionAttrib", "shapeCoordAttrib", "sourceCoordAttrib", "yCoordAttrib",
-        "backgroundColorAttrib", 0
+        "backgroundColorAttrib", "shapeParametersAttrib", 0
     };
     return attributes;
 }
@@ -82,13 +249,21 @@ void ShapeShader::initialize()
     program()->setUniformValue("shapeTexture", 0);
     program()->setUniformValue("sourceTexture", 1);
 
-    m_functions = QOpenGLContext::currentContext()->functions();
+    m_context = QOpenGLContext::currentContext();
+    m_functions = m_context->functions();
+    refShapeTextures(m_context, m_shapeTexturesId);
     m_matrixId = program()->uniformLocation("matrix");
     m_opacityFactorsId = program()->uniformLocation("opacityFactors");
-    m_sourceOpacityId = program()->uniformLocation("sourceOpacity");
-    m_distanceAAId = program()->uniformLocation("distanceAA");
     m_texturedId = program()->uniformLocation("textured");
     m_aspectId = program()->uniformLocation("aspect");
+
+    if (useDistanceFields()) {
+        // Send anti-aliasing distance in distance field space, needs to be divided by 2 for the
+        // shader. It is scaled per shape in the vertex shader by the distance AA factor stored in
+        // the shape parameters vertex attribute, so that it doesn't prevent batching.
+        const float distanceAA = (shapeTextureDistanceAA * distanceAApx) / 2.0f;
+        program()->setUniformValue("distanceAAScale", distanceAA);
+    }
 }
 
 void ShapeShader::updateState(
@@ -100,7 +275,7 @@ void ShapeShader::updateState(
     const ShapeMaterial::Data* data = material->constData();
 
     // Bind shape texture.
-    glBindTexture(GL_TEXTURE_2D, material->textureIds()[data->shapeTextureIndex]);
+    glBindTexture(GL_TEXTURE_2D, m_shapeTexturesId[data->shapeTextureIndex]);
 
     // Bind source texture on the 2nd texture unit and update uniforms.
     bool textured = false;
@@ -124,7 +299,6 @@ void ShapeShader::updateState(
             m_functions->glActiveTexture(GL_TEXTURE1);
             sourceTexture->bind();
             m_functions->glActiveTexture(GL_TEXTURE0);
-            program()->setUniformValue(m_sourceOpacityId, data->sourceOpacity / 255.0f);
             textured = true;
         }
     }
@@ -141,15 +315,6 @@ void ShapeShader::updateState(
         data->flags & ShapeMaterial::Data::Pressed ? pressedFactor * opacity : opacity, opacity);
     program()->setUniformValue(m_opacityFactorsId, opacityFactorsVector);
 
-    if (useDistanceFields()) {
-        // Send anti-aliasing distance in distance field space, needs to be divided by 2 for the
-        // shader and by 255 for distanceAAFactor dequantization. The factor is 1 most of the time
-        // apart when the radius size is low, it linearly goes from 1 to 0 to make the corners
-        // prettier and to prevent the opacity of the whole shape to slightly lower.
-        const float distanceAA = (shapeTextureDistanceAA * distanceAApx) / (2.0 * 255.0f);
-        program()->setUniformValue(m_distanceAAId, data->distanceAAFactor * distanceAA);
-    }
-
     // Update QtQuick engine uniforms.
     if (state.isMatrixDirty()) {
         program()->setUniformValue(m_matrixId, state.combinedMatrix());
@@ -158,82 +323,11 @@ void ShapeShader::updateState(
 
 // --- Scene graph material ---
 
-// Create and setup shape textures.
-static void createShapeTextures(QOpenGLContext* openglContext, quint32* ids)
-{
-    glGenTextures(shapeTextureCount, ids);
-
-    if (UCUbuntuShape::useDistanceFields(openglContext)) {
-        // Create distance field textures.
-        for (int i = 0; i < shapeTextureCount; i++) {
-            glBindTexture(GL_TEXTURE_2D, ids[i]);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, shapeTextureWidth, shapeTextureHeight, 0,
-                         GL_RGBA, GL_UNSIGNED_BYTE, shapeTextureData[i]);
-        }
-    } else {
-        // Create mipmap textures.
-        for (int i = 0; i < shapeTextureCount; i++) {
-            glBindTexture(GL_TEXTURE_2D, ids[i]);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            for (int j = 0; j < shapeTextureMipmapCount; j++) {
-                glTexImage2D(GL_TEXTURE_2D, j, GL_RGBA, shapeTextureMipmapWidth >> j,
-                             shapeTextureMipmapHeight >> j, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                             &shapeTextureMipmapData[i][shapeTextureMipmapOffset[j]]);
-            }
-        }
-    }
-}
-
-class ShapeTextures {
-public:
-    ShapeTextures() : m_refCount(0) {}
-    quint32* ids() { return m_ids; }
-    quint32 ref() { Q_ASSERT(m_refCount < UINT_MAX); return ++m_refCount; }
-    quint32 unref() { Q_ASSERT(m_refCount > 0); return --m_refCount; }
-private:
-    quint32 m_refCount;
-    quint32 m_ids[shapeTextureCount];
-};
-
-static QHash<QOpenGLContext*, ShapeTextures> shapeTexturesHash;
-static QMutex shapeTexturesHashMutex;
-
 ShapeMaterial::ShapeMaterial()
 {
-    // The whole struct (with the padding bytes) must be initialized for memcmp() to work as
-    // expected in ShapeMaterial::compare().
+    // Initialize the whole struct, including the padding bytes.
     memset(&m_data, 0x00, sizeof(Data));
     setFlag(Blending);
-
-    // Get or create the set of textures associated with the current context. We assume that QtQuick
-    // associates the same graphics context to a material for its entire lifetime.
-    QOpenGLContext* context = QOpenGLContext::currentContext();
-    shapeTexturesHashMutex.lock();
-    ShapeTextures& textures = shapeTexturesHash[context];
-    if (textures.ref() == 1) {
-        createShapeTextures(context, textures.ids());
-    }
-    memcpy(m_shapeTexturesId, textures.ids(), shapeTextureCount * sizeof(quint32));
-    shapeTexturesHashMutex.unlock();
-}
-
-ShapeMaterial::~ShapeMaterial()
-{
-    shapeTexturesHashMutex.lock();
-    auto it = shapeTexturesHash.find(QOpenGLContext::currentContext());
-    Q_ASSERT(it != shapeTexturesHash.end());
-    if (it.value().unref() == 0) {
-        glDeleteTextures(shapeTextureCount, it.value().ids());
-        shapeTexturesHash.erase(it);
-    }
-    shapeTexturesHashMutex.unlock();
 }
 
 QSGMaterialType* ShapeMaterial::type() const
@@ -249,12 +343,43 @@ QSGMaterialShader* ShapeMaterial::createShader() const
 
 int ShapeMaterial::compare(const QSGMaterial* other) const
 {
+    // Per-shape values (colors, source opacity, anti-aliasing factor) are stored in the vertices,
+    // so that shapes sharing the same radius and aspect class end up with equal materials and can
+    // be merged by the QtQuick batch renderer into a single draw call.
+    const ShapeMaterial::Data* otherData = static_cast<const ShapeMaterial*>(other)->constData();
+    if (m_data.flags != otherData->flags) {
+        return m_data.flags - otherData->flags;
+    }
+    if (m_data.shapeTextureIndex != otherData->shapeTextureIndex) {
+        return m_data.shapeTextureIndex - otherData->shapeTextureIndex;
+    }
+    if (!(m_data.flags & ShapeMaterial::Data::Textured)) {
+        return 0;
+    }
+
     // Repeat wrap modes require textures to be extracted from their atlases. Since we just store
     // the texture provider in the material data (not the texture as we want to do the extraction at
     // QSGShader::updateState() time), we make the comparison fail when repeat wrapping is set.
-    const ShapeMaterial::Data* otherData = static_cast<const ShapeMaterial*>(other)->constData();
-    return memcmp(&m_data, otherData, sizeof(m_data))
-        | (m_data.flags & ShapeMaterial::Data::Repeated);
+    if (m_data.flags & ShapeMaterial::Data::Repeated) {
+        return 1;
+    }
+    if (m_data.sourceTextureProvider == otherData->sourceTextureProvider) {
+        return 0;
+    }
+
+    // Different providers can still share a texture, that's typically the case for small images
+    // stored in the same QtQuick atlas. The source coordinates in the vertices already point to
+    // the right sub-rectangle so binding any of them gives the same result.
+    QSGTexture* texture = m_data.sourceTextureProvider ?
+        m_data.sourceTextureProvider->texture() : NULL;
+    QSGTexture* otherTexture = otherData->sourceTextureProvider ?
+        otherData->sourceTextureProvider->texture() : NULL;
+    if (texture && otherTexture) {
+        const int id = texture->textureId();
+        const int otherId = otherTexture->textureId();
+        return id - otherId;
+    }
+    return m_data.sourceTextureProvider < otherData->sourceTextureProvider ? -1 : 1;
 }
 
 void ShapeMaterial::updateTextures()
@@ -310,10 +435,11 @@ const QSGGeometry::AttributeSet& ShapeNode::attributeSet()
         QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
         QSGGeometry::Attribute::create(2, 4, GL_FLOAT),
         QSGGeometry::Attribute::create(3, 1, GL_FLOAT),
-        QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE)
+        QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(5, 4, GL_UNSIGNED_BYTE)
     };
     static const QSGGeometry::AttributeSet attributeSet = {
-        5, sizeof(Vertex), attributes
+        6, sizeof(Vertex), attributes
     };
     return attributeSet;
 }
@@ -1181,6 +1307,24 @@ static quint32 averageColor(QRgb c1, QRgb c2)
         (qGreen(c1) + qGreen(c2)) >> 1, (qRed(c1) + qRed(c2)) >> 1);
 }
 
+// Pack the per-shape parameters in a 32-bit integer read as a normalized unsigned byte vector by
+// the vertex shader. x stores the quantized distance field anti-aliasing factor and y the source
+// opacity. The factor is 1 most of the time apart when the radius size is low, it linearly goes
+// from 1 to 0 to make the corners prettier and to prevent the opacity of the whole shape to
+// slightly lower.
+static quint32 packShapeParameters(float radius, quint8 sourceOpacity)
+{
+    const float physicalRadius = radius * qGuiApp->devicePixelRatio();
+
+    // Mapping of radius size range from [0, 4] to [0, 1] with clamping, plus quantization.
+    const float start = 0.0f + radiusSizeOffset;
+    const float end = 4.0f + radiusSizeOffset;
+    const quint32 distanceAAFactor = static_cast<quint32>(
+        qBound(0.0f, (physicalRadius / (end - start)) - (start / (end - start)), 1.0f) * 255.0f);
+
+    return (static_cast<quint32>(sourceOpacity) << 8) | distanceAAFactor;
+}
+
 QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data)
 {
     Q_UNUSED(data);
@@ -1252,7 +1396,8 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
                      / qGuiApp->devicePixelRatio();
     }
 
-    updateMaterial(node, radius, m_aspect != DropShadow ? 0 : 1, sourceTexture && m_sourceOpacity);
+    const bool textured = sourceTexture && m_sourceOpacity;
+    updateMaterial(node, radius, m_aspect != DropShadow ? 0 : 1, textured);
 
     // Get the affine transformation for the source texture coordinates.
     const QVector4D sourceCoordTransform(
@@ -1297,7 +1442,7 @@ QSGNode* UCUbuntuShape::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* d
 
     updateGeometry(
         node, itemSize, radius, shapeTextureOffset, sourceCoordTransform, sourceMaskTransform,
-        backgroundColor);
+        backgroundColor, packShapeParameters(radius, textured ? m_sourceOpacity : 0));
 
     return node;
 }
@@ -1316,7 +1461,6 @@ void UCUbuntuShape::updateMaterial(
     materialData->shapeTextureIndex = shapeTextureIndex;
     if (textured) {
         materialData->sourceTextureProvider = m_sourceTextureProvider;
-        materialData->sourceOpacity = m_sourceOpacity;
         if (m_sourceHorizontalWrapMode == Repeat) {
             flags |= ShapeMaterial::Data::HorizontallyRepeated;
         }
@@ -1326,18 +1470,10 @@ void UCUbuntuShape::updateMaterial(
         flags |= ShapeMaterial::Data::Textured;
     } else {
         materialData->sourceTextureProvider = NULL;
-        materialData->sourceOpacity = 0;
     }
 
     const float physicalRadius = radius * qGuiApp->devicePixelRatio();
 
-    // Mapping of radius size range from [0, 4] to [0, 1] with clamping, plus quantization.
-    const float start = 0.0f + radiusSizeOffset;
-    const float end = 4.0f + radiusSizeOffset;
-
-    materialData->distanceAAFactor =
-        qMin((physicalRadius / (end - start)) - (start / (end - start)), 1.0f) * 255.0f;
-
     // When the radius is equal to radiusSizeOffset (which means radius size is 0), no aspect is
     // flagged so that a dedicated (statically flow controlled) shaved off shader can be used for
     // optimal performance.
@@ -1358,7 +1494,7 @@ void UCUbuntuShape::updateMaterial(
 void UCUbuntuShape::updateGeometry(
     QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
     const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-    const quint32 backgroundColor[3])
+    const quint32 backgroundColor[3], quint32 shapeParameters)
 {
     // Used by subclasses, using the shapeTextureOffset constant directly allows slightly
     // better optimization here.
@@ -1378,6 +1514,7 @@ void UCUbuntuShape::updateGeometry(
     v[0].sourceCoordinate[3] = sourceMaskTransform.w();
     v[0].yCoordinate = -1.0f;
     v[0].backgroundColor = backgroundColor[0];
+    v[0].shapeParameters = shapeParameters;
     v[1].position[0] = 0.5f * itemSize.width();
     v[1].position[1] = 0.0f;
     v[1].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1388,6 +1525,7 @@ void UCUbuntuShape::updateGeometry(
     v[1].sourceCoordinate[3] = sourceMaskTransform.w();
     v[1].yCoordinate = -1.0f;
     v[1].backgroundColor = backgroundColor[0];
+    v[1].shapeParameters = shapeParameters;
     v[2].position[0] = itemSize.width();
     v[2].position[1] = 0.0f;
     v[2].shapeCoordinate[0] = shapeTextureOffset;
@@ -1398,6 +1536,7 @@ void UCUbuntuShape::updateGeometry(
     v[2].sourceCoordinate[3] = sourceMaskTransform.w();
     v[2].yCoordinate = -1.0f;
     v[2].backgroundColor = backgroundColor[0];
+    v[2].shapeParameters = shapeParameters;
 
     // Set middle row of 3 vertices.
     v[3].position[0] = 0.0f;
@@ -1410,6 +1549,7 @@ void UCUbuntuShape::updateGeometry(
     v[3].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[3].yCoordinate = 0.0f;
     v[3].backgroundColor = backgroundColor[1];
+    v[3].shapeParameters = shapeParameters;
     v[4].position[0] = 0.5f * itemSize.width();
     v[4].position[1] = 0.5f * itemSize.height();
     v[4].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1420,6 +1560,7 @@ void UCUbuntuShape::updateGeometry(
     v[4].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[4].yCoordinate = 0.0f;
     v[4].backgroundColor = backgroundColor[1];
+    v[4].shapeParameters = shapeParameters;
     v[5].position[0] = itemSize.width();
     v[5].position[1] = 0.5f * itemSize.height();
     v[5].shapeCoordinate[0] = shapeTextureOffset;
@@ -1430,6 +1571,7 @@ void UCUbuntuShape::updateGeometry(
     v[5].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[5].yCoordinate = 0.0f;
     v[5].backgroundColor = backgroundColor[1];
+    v[5].shapeParameters = shapeParameters;
 
     // Set bottom row of 3 vertices.
     v[6].position[0] = 0.0f;
@@ -1442,6 +1584,7 @@ void UCUbuntuShape::updateGeometry(
     v[6].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[6].yCoordinate = 1.0f;
     v[6].backgroundColor = backgroundColor[2];
+    v[6].shapeParameters = shapeParameters;
     v[7].position[0] = 0.5f * itemSize.width();
     v[7].position[1] = itemSize.height();
     v[7].shapeCoordinate[0] = (0.5f * itemSize.width()) / radius - shapeTextureOffset;
@@ -1452,6 +1595,7 @@ void UCUbuntuShape::updateGeometry(
     v[7].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[7].yCoordinate = 1.0f;
     v[7].backgroundColor = backgroundColor[2];
+    v[7].shapeParameters = shapeParameters;
     v[8].position[0] = itemSize.width();
     v[8].position[1] = itemSize.height();
     v[8].shapeCoordinate[0] = shapeTextureOffset;
@@ -1462,6 +1606,7 @@ void UCUbuntuShape::updateGeometry(
     v[8].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[8].yCoordinate = 1.0f;
     v[8].backgroundColor = backgroundColor[2];
+    v[8].shapeParameters = shapeParameters;
 
     node->markDirty(QSGNode::DirtyGeometry);
 }
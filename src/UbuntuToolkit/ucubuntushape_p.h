@@ -27,14 +27,20 @@
 #include <UbuntuToolkit/private/ucimportversionchecker_p.h>
 #include <UbuntuToolkit/private/ucubuntushapetextures_p.h>
 
-// --- Scene graph shader ---
-
 UT_NAMESPACE_BEGIN
 
+// --- Scene graph textures ---
+
+// Fills data (shapeTextureMipmapSize bytes) with the mipmap levels of the shape texture at index.
+UBUNTUTOOLKIT_EXPORT void createShapeTextureMipmaps(int index, quint8* data);
+
+// --- Scene graph shader ---
+
 class ShapeShader : public QSGMaterialShader
 {
 public:
     ShapeShader();
+    ~ShapeShader();
     char const* const* attributeNames() const override;
     void initialize() override;
     void updateState(
@@ -43,11 +49,11 @@ public:
 
 private:
     QOpenGLFunctions* m_functions;
+    QOpenGLContext* m_context;
+    quint32 m_shapeTexturesId[shapeTextureCount];
     bool m_useDistanceFields;
     int m_matrixId;
     int m_opacityFactorsId;
-    int m_sourceOpacityId;
-    int m_distanceAAId;
     int m_texturedId;
     int m_aspectId;
 };
@@ -71,24 +77,19 @@ public:
         };
         QSGTextureProvider* sourceTextureProvider;
         quint8 shapeTextureIndex;
-        quint8 distanceAAFactor;
-        quint8 sourceOpacity;
         quint8 flags;
     };
 
     ShapeMaterial();
-    ~ShapeMaterial();
     QSGMaterialType* type() const override;
     QSGMaterialShader* createShader() const override;
     int compare(const QSGMaterial* other) const override;
     virtual void updateTextures();
     const Data* constData() const { return &m_data; }
     Data* data() { return &m_data; }
-    quint32* textureIds() { return m_shapeTexturesId; }
 
 private:
     Data m_data;
-    quint32 m_shapeTexturesId[shapeTextureCount];
 };
 
 // --- Scene graph node ---
@@ -102,6 +103,7 @@ public:
         float sourceCoordinate[4];
         float yCoordinate;
         quint32 backgroundColor;
+        quint32 shapeParameters;
     };
 
     static const int indexCount = 14;
@@ -307,7 +309,7 @@ protected:
     virtual void updateGeometry(
         QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
         const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-        const quint32 backgroundColor[3]);
+        const quint32 backgroundColor[3], quint32 shapeParameters);
 
 private Q_SLOTS:
     void _q_imagePropertiesChanged();
@@ -38,7 +38,7 @@ char const* const* ShapeOverlayShader::attributeNames() const
 {
     static char const* const attributes[] = {
         "positionAttrib", "shapeCoordAttrib", "sourceCoordAttrib", "yCoordAttrib",
-        "backgroundColorAttrib", "overlayCoordAttrib", "overlayColorAttrib", 0
+        "backgroundColorAttrib", "shapeParametersAttrib", "overlayCoordAttrib", "overlayColorAttrib", 0
     };
     return attributes;
 }
@@ -86,11 +86,12 @@ const QSGGeometry::AttributeSet& ShapeOverlayNode::attributeSet()
         QSGGeometry::Attribute::create(2, 4, GL_FLOAT),
         QSGGeometry::Attribute::create(3, 1, GL_FLOAT),
         QSGGeometry::Attribute::create(4, 4, GL_UNSIGNED_BYTE),
-        QSGGeometry::Attribute::create(5, 2, GL_FLOAT),
-        QSGGeometry::Attribute::create(6, 4, GL_UNSIGNED_BYTE)
+        QSGGeometry::Attribute::create(5, 4, GL_UNSIGNED_BYTE),
+        QSGGeometry::Attribute::create(6, 2, GL_FLOAT),
+        QSGGeometry::Attribute::create(7, 4, GL_UNSIGNED_BYTE)
     };
     static const QSGGeometry::AttributeSet attributeSet = {
-        7, sizeof(Vertex), attributes
+        8, sizeof(Vertex), attributes
     };
     return attributeSet;
 }
@@ -225,7 +226,7 @@ static quint32 packColor(QRgb color)
 void UCUbuntuShapeOverlay::updateGeometry(
     QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
     const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-    const quint32 backgroundColor[3])
+    const quint32 backgroundColor[3], quint32 shapeParameters)
 {
     ShapeOverlayNode::Vertex* v = reinterpret_cast<ShapeOverlayNode::Vertex*>(
         static_cast<ShapeOverlayNode*>(node)->geometry()->vertexData());
@@ -256,6 +257,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[0].sourceCoordinate[3] = sourceMaskTransform.w();
     v[0].yCoordinate = -1.0f;
     v[0].backgroundColor = backgroundColor[0];
+    v[0].shapeParameters = shapeParameters;
     v[0].overlayCoordinate[0] = overlayTx;
     v[0].overlayCoordinate[1] = overlayTy;
     v[0].overlayColor = overlayColor;
@@ -269,6 +271,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[1].sourceCoordinate[3] = sourceMaskTransform.w();
     v[1].yCoordinate = -1.0f;
     v[1].backgroundColor = backgroundColor[0];
+    v[1].shapeParameters = shapeParameters;
     v[1].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[1].overlayCoordinate[1] = overlayTy;
     v[1].overlayColor = overlayColor;
@@ -282,6 +285,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[2].sourceCoordinate[3] = sourceMaskTransform.w();
     v[2].yCoordinate = -1.0f;
     v[2].backgroundColor = backgroundColor[0];
+    v[2].shapeParameters = shapeParameters;
     v[2].overlayCoordinate[0] = overlaySx + overlayTx;
     v[2].overlayCoordinate[1] = overlayTy;
     v[2].overlayColor = overlayColor;
@@ -297,6 +301,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[3].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[3].yCoordinate = 0.0f;
     v[3].backgroundColor = backgroundColor[1];
+    v[3].shapeParameters = shapeParameters;
     v[3].overlayCoordinate[0] = overlayTx;
     v[3].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[3].overlayColor = overlayColor;
@@ -310,6 +315,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[4].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[4].yCoordinate = 0.0f;
     v[4].backgroundColor = backgroundColor[1];
+    v[4].shapeParameters = shapeParameters;
     v[4].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[4].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[4].overlayColor = overlayColor;
@@ -323,6 +329,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[5].sourceCoordinate[3] = 0.5f * sourceMaskTransform.y() + sourceMaskTransform.w();
     v[5].yCoordinate = 0.0f;
     v[5].backgroundColor = backgroundColor[1];
+    v[5].shapeParameters = shapeParameters;
     v[5].overlayCoordinate[0] = overlaySx + overlayTx;
     v[5].overlayCoordinate[1] = 0.5f * overlaySy + overlayTy;
     v[5].overlayColor = overlayColor;
@@ -338,6 +345,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[6].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[6].yCoordinate = 1.0f;
     v[6].backgroundColor = backgroundColor[2];
+    v[6].shapeParameters = shapeParameters;
     v[6].overlayCoordinate[0] = overlayTx;
     v[6].overlayCoordinate[1] = overlaySy + overlayTy;
     v[6].overlayColor = overlayColor;
@@ -351,6 +359,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[7].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[7].yCoordinate = 1.0f;
     v[7].backgroundColor = backgroundColor[2];
+    v[7].shapeParameters = shapeParameters;
     v[7].overlayCoordinate[0] = 0.5f * overlaySx + overlayTx;
     v[7].overlayCoordinate[1] = overlaySy + overlayTy;
     v[7].overlayColor = overlayColor;
@@ -364,6 +373,7 @@ void UCUbuntuShapeOverlay::updateGeometry(
     v[8].sourceCoordinate[3] = sourceMaskTransform.y() + sourceMaskTransform.w();
     v[8].yCoordinate = 1.0f;
     v[8].backgroundColor = backgroundColor[2];
+    v[8].shapeParameters = shapeParameters;
     v[8].overlayCoordinate[0] = overlaySx + overlayTx;
     v[8].overlayCoordinate[1] = overlaySy + overlayTy;
     v[8].overlayColor = overlayColor;
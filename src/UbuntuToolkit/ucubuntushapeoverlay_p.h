@@ -52,6 +52,7 @@ public:
         float sourceCoordinate[4];
         float yCoordinate;
         quint32 backgroundColor;
+        quint32 shapeParameters;
         float overlayCoordinate[2];
         quint32 overlayColor;
     };
@@ -98,7 +99,7 @@ protected:
     void updateGeometry(
         QSGNode* node, const QSizeF& itemSize, float radius, float shapeOffset,
         const QVector4D& sourceCoordTransform, const QVector4D& sourceMaskTransform,
-        const quint32 backgroundColor[3]) override;
+        const quint32 backgroundColor[3], quint32 shapeParameters) override;
 
 private:
     quint16 m_overlayX;
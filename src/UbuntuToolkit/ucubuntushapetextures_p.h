@@ -14,8 +14,6 @@ extern const unsigned char shapeTextureData[2][4097];
 const int shapeTextureMipmapWidth = 256;
 const int shapeTextureMipmapHeight = 256;
 const int shapeTextureMipmapCount = 9;
-
-extern const int shapeTextureMipmapOffset[9];
-extern const unsigned char shapeTextureMipmapData[2][349525];
+const int shapeTextureMipmapSize = 349524;
 
 #endif // UCUBUNTUSHAPETEXTURES_H
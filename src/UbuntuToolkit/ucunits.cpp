@@ -20,7 +20,7 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
-#include <QtCore/QRegularExpression>
+#include <QtCore/QFileSystemWatcher>
 #include <QtCore/QtMath>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QScreen>
@@ -31,6 +31,8 @@
 #include <QtQml/QQmlFile>
 #include <QtGui/private/qhighdpiscaling_p.h>
 
+#include <algorithm>
+
 #define ENV_GRID_UNIT_PX "GRID_UNIT_PX"
 #define DEFAULT_GRID_UNIT_PX 8
 
@@ -100,7 +102,8 @@ static float getenvFloat(const char* name, float defaultValue)
 
 UCUnits::UCUnits(QWindow *parent) :
     QObject(parent),
-    m_devicePixelRatio(parent->devicePixelRatio())
+    m_devicePixelRatio(parent->devicePixelRatio()),
+    m_assetWatcher(nullptr)
 {
     m_gridUnit = getenvFloat(ENV_GRID_UNIT_PX, DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
     QObject::connect(parent, &QWindow::screenChanged,
@@ -133,7 +136,8 @@ UCUnits *UCUnits::m_units = nullptr;
 
 UCUnits::UCUnits(QObject *parent) :
     QObject(parent),
-    m_devicePixelRatio(qGuiApp->devicePixelRatio())
+    m_devicePixelRatio(qGuiApp->devicePixelRatio()),
+    m_assetWatcher(nullptr)
 {
     if (QHighDpiScaling::isActive())
       m_gridUnit = qCeil(DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
@@ -213,8 +217,14 @@ QString UCUnits::resolveResource(const QUrl& url)
     }
 
     const QFileInfo fileInfo(path);
-    if (fileInfo.exists()) {
-        if (fileInfo.isFile()) {
+    const AssetDirectory *directory = assetDirectory(fileInfo.dir().absolutePath());
+    if (!directory) {
+        return QString();
+    }
+
+    QHash<QString, bool>::const_iterator entry = directory->entries.constFind(fileInfo.fileName());
+    if (entry != directory->entries.constEnd()) {
+        if (entry.value()) {
             return QStringLiteral("1/") + path;
         } else {
             return QString();
@@ -227,16 +237,15 @@ QString UCUnits::resolveResource(const QUrl& url)
     /* Use file with expected grid unit suffix if it exists.
        For example, if m_gridUnit = 10, look for resource@10.png.
     */
-
-    path = prefix + suffixForGridUnit(m_gridUnit) + suffix;
-    if (QFile::exists(path)) {
-        return QStringLiteral("1/") + path;
+    const QString gridUnitSuffix = suffixForGridUnit(m_gridUnit);
+    if (directory->entries.contains(fileInfo.baseName() + gridUnitSuffix + suffix)) {
+        return QStringLiteral("1/") + prefix + gridUnitSuffix + suffix;
     }
 
     /* No file with expected grid unit suffix exists.
-       List all the files of the form fileBaseName@[0-9]*.fileSuffix and select
-       the most appropriate one privileging downscaling high resolution assets
-       over upscaling low resolution assets.
+       Among the files of the form fileBaseName@[0-9]*.fileSuffix select the most
+       appropriate one privileging downscaling high resolution assets over upscaling
+       low resolution assets.
 
        The most appropriate file has a grid unit suffix greater than the target
        grid unit (m_gridUnit) yet as small as possible.
@@ -249,20 +258,12 @@ QString UCUnits::resolveResource(const QUrl& url)
        file would be resource@14.png since it is above 10 and smaller
        than resource@18.png.
     */
-    QStringList nameFilters;
-    nameFilters << fileInfo.baseName() + "@[0-9]*" + suffix;
-    const QStringList files = fileInfo.dir().entryList(nameFilters, QDir::Files);
-
-    if (!files.empty()) {
-        float selectedGridUnitSuffix = gridUnitSuffixFromFileName(files.first());
-
-        Q_FOREACH (const QString& fileName, files) {
-            float gridUnitSuffix = gridUnitSuffixFromFileName(fileName);
-            if ((selectedGridUnitSuffix >= m_gridUnit && gridUnitSuffix >= m_gridUnit && gridUnitSuffix < selectedGridUnitSuffix)
-                || (selectedGridUnitSuffix < m_gridUnit && gridUnitSuffix > selectedGridUnitSuffix)) {
-                selectedGridUnitSuffix = gridUnitSuffix;
-            }
-        }
+    const QVector<float> gridUnits =
+        directory->variants.value(fileInfo.baseName() + QLatin1Char('\n') + suffix);
+    if (!gridUnits.isEmpty()) {
+        QVector<float>::const_iterator match =
+            std::lower_bound(gridUnits.constBegin(), gridUnits.constEnd(), m_gridUnit);
+        float selectedGridUnitSuffix = match != gridUnits.constEnd() ? *match : gridUnits.last();
 
         path = prefix + suffixForGridUnit(selectedGridUnitSuffix) + suffix;
         float scaleFactor = m_gridUnit / selectedGridUnitSuffix;
@@ -272,20 +273,63 @@ QString UCUnits::resolveResource(const QUrl& url)
     return QString();
 }
 
-QString UCUnits::suffixForGridUnit(float gridUnit)
+/* Returns the index of an asset directory, listing the directory on the first request.
+   Local directories are watched and listed again once they change; resource directories
+   never change. Returns null if the directory does not exist.
+*/
+const UCUnits::AssetDirectory *UCUnits::assetDirectory(const QString &path)
 {
-    return "@" + QString::number(gridUnit);
+    QHash<QString, AssetDirectory>::const_iterator cached = m_assetDirectories.constFind(path);
+    if (cached != m_assetDirectories.constEnd()) {
+        return &cached.value();
+    }
+
+    const QDir dir(path);
+    if (!dir.exists()) {
+        return nullptr;
+    }
+
+    AssetDirectory directory;
+    const QFileInfoList entries = dir.entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot);
+    Q_FOREACH (const QFileInfo &entry, entries) {
+        const QString fileName = entry.fileName();
+        directory.entries.insert(fileName, entry.isFile());
+        if (!entry.isFile()) {
+            continue;
+        }
+
+        // name@<digits><suffix>
+        const int at = fileName.indexOf(QLatin1Char('@'));
+        int digitsEnd = at + 1;
+        while (at >= 0 && digitsEnd < fileName.length() && fileName.at(digitsEnd).isDigit()) {
+            digitsEnd++;
+        }
+        if (at < 0 || digitsEnd == at + 1) {
+            continue;
+        }
+        const QString key = fileName.left(at) + QLatin1Char('\n') + fileName.mid(digitsEnd);
+        QVector<float> &gridUnits = directory.variants[key];
+        const float gridUnit = fileName.midRef(at + 1, digitsEnd - at - 1).toFloat();
+        gridUnits.insert(std::lower_bound(gridUnits.begin(), gridUnits.end(), gridUnit), gridUnit);
+    }
+
+    if (!path.startsWith(QLatin1Char(':'))) {
+        if (!m_assetWatcher) {
+            m_assetWatcher = new QFileSystemWatcher(this);
+            QObject::connect(m_assetWatcher, &QFileSystemWatcher::directoryChanged,
+                             this, [this](const QString &changedPath) {
+                m_assetDirectories.remove(changedPath);
+                m_assetWatcher->removePath(changedPath);
+            });
+        }
+        m_assetWatcher->addPath(path);
+    }
+    return &m_assetDirectories.insert(path, directory).value();
 }
 
-float UCUnits::gridUnitSuffixFromFileName(const QString& fileName)
+QString UCUnits::suffixForGridUnit(float gridUnit)
 {
-    QRegularExpression re(QStringLiteral("^.*@([0-9]*).*$"));
-    QRegularExpressionMatch match = re.match(fileName);
-    if (match.hasMatch()) {
-        return match.captured(1).toFloat();
-    } else {
-        return 0;
-    }
+    return "@" + QString::number(gridUnit);
 }
 
 void UCUnits::windowPropertyChanged(QPlatformWindow *window, const QString &propertyName)
@@ -23,10 +23,12 @@
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
+#include <QtCore/QVector>
 #include <QtGui/QWindow>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
+class QFileSystemWatcher;
 class QPlatformWindow;
 
 UT_NAMESPACE_BEGIN
@@ -66,7 +68,6 @@ Q_SIGNALS:
 
 protected:
     QString suffixForGridUnit(float gridUnit);
-    float gridUnitSuffixFromFileName(const QString &fileName);
 
 private Q_SLOTS:
     void windowPropertyChanged(QPlatformWindow *window, const QString &propertyName);
@@ -74,10 +75,21 @@ private Q_SLOTS:
     void devicePixelRatioChanged(qreal dpi);
 
 private:
+    // the entries of an asset directory and the grid unit variants of its assets
+    struct AssetDirectory {
+        // file name -> whether the entry is a file
+        QHash<QString, bool> entries;
+        // base name + '\n' + suffix -> ascending grid units of the name@<gu>.suffix files
+        QHash<QString, QVector<float> > variants;
+    };
+    const AssetDirectory *assetDirectory(const QString &path);
+
     static UCUnits *m_units;
     float m_devicePixelRatio;
     QScreen *m_screen;
     float m_gridUnit;
+    QHash<QString, AssetDirectory> m_assetDirectories;
+    QFileSystemWatcher *m_assetWatcher;
 };
 
 UT_NAMESPACE_END
@@ -303,6 +303,7 @@ void UCViewItemsAttached::setSelectMode(bool value)
  * indexes are model indexes when used in ListView, and child indexes in other
  * components. The property being writable, initial selection configuration
  * can be provided for a view, and provides ability to save the selection state.
+ * The indexes are listed in ascending order.
  */
 QList<int> UCViewItemsAttached::selectedIndices() const
 {
@@ -312,18 +313,59 @@ QList<int> UCViewItemsAttached::selectedIndices() const
 void UCViewItemsAttached::setSelectedIndices(const QList<int> &list)
 {
     Q_D(UCViewItemsAttached);
-    if (d->selectedList.toList() == list) {
+    IndexRanges selection = IndexRanges::fromList(list);
+    if (d->selectedList == selection) {
         return;
     }
-    d->selectedList = QSet<int>::fromList(list);
+    d->selectedList = selection;
     Q_EMIT selectedIndicesChanged(list);
 }
 
+/*!
+ * \qmlattachedmethod void ViewItems::selectRange(int from, int to)
+ * \since Ubuntu.Components 1.3
+ * Adds the indexes between \a from and \a to, inclusive, to the
+ * \l selectedIndices. The change is notified once, whatever the size of the range.
+ * The range is limited to the items of the ListView, or to the children of the Item
+ * the ViewItems is attached to.
+ */
+void UCViewItemsAttached::selectRange(int from, int to)
+{
+    Q_D(UCViewItemsAttached);
+    int first = qMax(qMin(from, to), 0);
+    int last = qMin(qMax(from, to), d->itemCount() - 1);
+    if (d->selectedList.insert(first, last)) {
+        Q_EMIT selectedIndicesChanged(d->selectedList.toList());
+    }
+}
+
+/*!
+ * \qmlattachedmethod void ViewItems::selectAll()
+ * \since Ubuntu.Components 1.3
+ * Selects all the items of the ListView, or all the children of the Item the
+ * ViewItems is attached to.
+ */
+void UCViewItemsAttached::selectAll()
+{
+    Q_D(UCViewItemsAttached);
+    selectRange(0, d->itemCount() - 1);
+}
+
+// the number of items of the ListView, or of children of the owner Item
+int UCViewItemsAttachedPrivate::itemCount() const
+{
+    Q_Q(const UCViewItemsAttached);
+    if (listView) {
+        return listView->count();
+    }
+    QQuickItem *owner = qobject_cast<QQuickItem*>(q->parent());
+    return owner ? owner->childItems().count() : 0;
+}
+
 bool UCViewItemsAttachedPrivate::addSelectedItem(UCListItem *item)
 {
     int index = UCListItemPrivate::get(item)->index();
-    if (!selectedList.contains(index)) {
-        selectedList.insert(index);
+    if (selectedList.insert(index, index)) {
         Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
         return true;
     }
@@ -331,7 +373,8 @@ bool UCViewItemsAttachedPrivate::addSelectedItem(UCListItem *item)
 }
 bool UCViewItemsAttachedPrivate::removeSelectedItem(UCListItem *item)
 {
-    if (selectedList.remove(UCListItemPrivate::get(item)->index()) > 0) {
+    int index = UCListItemPrivate::get(item)->index();
+    if (selectedList.remove(index, index)) {
         Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
         return true;
     }
@@ -545,32 +588,9 @@ void UCViewItemsAttachedPrivate::updateSelectedIndices(int fromIndex, int toInde
         return;
     }
 
-    Q_Q(UCViewItemsAttached);
-    bool isFromSelected = selectedList.contains(fromIndex);
-    if (isFromSelected) {
-        selectedList.remove(fromIndex);
-        Q_EMIT q->selectedIndicesChanged(selectedList.toList());
-    }
-    // direction is -1 (forwards) or 1 (backwards)
-    int direction = (fromIndex < toIndex) ? -1 : 1;
-    int i = (direction < 0) ? fromIndex + 1 : fromIndex - 1;
-    // loop thru the selectedIndices and fix all indices
-    while (1) {
-        if (((direction < 0) && (i > toIndex)) ||
-            ((direction > 0) && (i < toIndex))) {
-            break;
-        }
-
-        if (selectedList.contains(i)) {
-            selectedList.remove(i);
-            selectedList.insert(i + direction);
-            Q_EMIT q->selectedIndicesChanged(selectedList.toList());
-        }
-        i -= direction;
-    }
-    if (isFromSelected) {
-        selectedList.insert(toIndex);
-        Q_EMIT q->selectedIndicesChanged(selectedList.toList());
+    // the selected indices between fromIndex and toIndex are shifted all at once
+    if (selectedList.move(fromIndex, toIndex)) {
+        Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
     }
 }
 
@@ -18,10 +18,16 @@
 
 #include "unitythemeiconprovider_p.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
 #include <QtCore/QtDebug>
 #include <QtGui/QImageReader>
 
@@ -33,9 +39,13 @@ public:
     typedef QSharedPointer<class IconTheme> IconThemePointer;
 
     // Returns the icon theme named @name, creating it if it didn't exist yet.
+    // Image providers run in the loader threads, hence the lock. It is recursive
+    // as creating a theme also gets its parents.
     static IconThemePointer get(const QString &name)
     {
+        static QMutex mutex(QMutex::Recursive);
         static QHash<QString, IconThemePointer> themes;
+        QMutexLocker locker(&mutex);
 
         IconThemePointer theme = themes[name];
         if (theme.isNull()) {
@@ -81,7 +91,7 @@ private:
         int size, minSize, maxSize, threshold;
     };
 
-    IconTheme(const QString &name): name(name)
+    IconTheme(const QString &name): name(name), indexDirty(1)
     {
         const QStringList paths = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
 
@@ -122,6 +132,75 @@ private:
                 break;
             }
         }
+
+        watchDirectories();
+    }
+
+    // Marks the index outdated whenever a theme directory changes. The watcher needs an
+    // event loop, so it lives in the application thread and themes created elsewhere
+    // are not watched.
+    void watchDirectories()
+    {
+        QCoreApplication *application = QCoreApplication::instance();
+        if (!application || QThread::currentThread() != application->thread()) {
+            return;
+        }
+
+        QStringList paths;
+        Q_FOREACH(const QString &baseDir, baseDirs) {
+            paths.append(baseDir);
+            Q_FOREACH(const Directory &dir, directories) {
+                const QString path = baseDir + "/" + dir.path;
+                if (QFileInfo(path).isDir())
+                    paths.append(path);
+            }
+        }
+        if (paths.isEmpty())
+            return;
+
+        // deleted together with the application
+        watcher = new QFileSystemWatcher(paths, application);
+        QObject::connect(watcher.data(), &QFileSystemWatcher::directoryChanged,
+                         [this]() { indexDirty.storeRelease(1); });
+    }
+
+    // Returns the files of the icon named @iconName, one per theme directory, a null
+    // string meaning the directory has no such icon. The index is (re)built when needed.
+    QVector<QString> iconFiles(const QString &iconName)
+    {
+        if (indexDirty.loadAcquire()) {
+            QWriteLocker locker(&indexLock);
+            if (indexDirty.testAndSetOrdered(1, 0))
+                buildIndex();
+        }
+        QReadLocker locker(&indexLock);
+        return index.value(iconName);
+    }
+
+    // Lists every theme directory once. As lookups used to, earlier base directories take
+    // precedence, and png icons over svg ones in the same directory.
+    void buildIndex()
+    {
+        static const QStringList suffixes = QStringList() << QStringLiteral(".png") << QStringLiteral(".svg");
+        const int count = directories.count();
+
+        index.clear();
+        for (int i = 0; i < count; i++) {
+            Q_FOREACH(const QString &baseDir, baseDirs) {
+                const QDir dir(baseDir + "/" + directories[i].path);
+                Q_FOREACH(const QString &suffix, suffixes) {
+                    const QStringList files = dir.entryList(QStringList() << "*" + suffix,
+                                                            QDir::Files | QDir::CaseSensitive);
+                    Q_FOREACH(const QString &file, files) {
+                        QVector<QString> &entry = index[file.left(file.length() - suffix.length())];
+                        if (entry.isEmpty())
+                            entry.resize(count);
+                        if (entry[i].isNull())
+                            entry[i] = dir.filePath(file);
+                    }
+                }
+            }
+        }
     }
 
     SizeType sizeTypeFromString(const QString &string)
@@ -173,24 +252,6 @@ private:
         }
     }
 
-    QString lookupIconFile(const QString &dir, const QString &name)
-    {
-        QString png = QStringLiteral("%1/%2.png").arg(dir, name);
-        QString svg = QStringLiteral("%1/%2.svg").arg(dir, name);
-
-        Q_FOREACH(const QString &baseDir, baseDirs) {
-            QString filename = baseDir + "/" + png;
-            if (QFileInfo::exists(filename))
-                return filename;
-
-            filename = baseDir + "/" + svg;
-            if (QFileInfo::exists(filename))
-                return filename;
-        }
-
-        return QString();
-    }
-
     QImage lookupIcon(const QString &iconName, QSize *impsize, const QSize &size)
     {
         const int iconSize = qMax(size.width(), size.height());
@@ -204,13 +265,14 @@ private:
     {
         int minDistance = 10000;
         QString bestFilename;
+        const QVector<QString> files = iconFiles(iconName);
 
-        Q_FOREACH(const Directory &dir, directories) {
-            int dist = directorySizeDistance(dir, size);
+        for (int i = 0; i < files.count(); i++) {
+            int dist = directorySizeDistance(directories[i], size);
             if (dist >= minDistance)
                 continue;
 
-            QString filename = lookupIconFile(dir.path, iconName);
+            const QString &filename = files[i];
             if (!filename.isNull()) {
                 minDistance = dist;
                 bestFilename = filename;
@@ -231,13 +293,15 @@ private:
     {
         int maxSize = 0;
         QString bestFilename;
+        const QVector<QString> files = iconFiles(iconName);
 
-        Q_FOREACH(const Directory &dir, directories) {
+        for (int i = 0; i < files.count(); i++) {
+            const Directory &dir = directories[i];
             int size = dir.sizeType == Scalable ? dir.maxSize : dir.size;
             if (size < maxSize)
                 continue;
 
-            QString filename = lookupIconFile(dir.path, iconName);
+            const QString &filename = files[i];
             if (!filename.isNull()) {
                 maxSize = size;
                 bestFilename = filename;
@@ -272,12 +336,20 @@ private:
     QStringList baseDirs;
     QList<Directory> directories;
     QList<IconThemePointer> parents;
+
+    // icon name -> file per theme directory
+    QHash<QString, QVector<QString> > index;
+    QReadWriteLock indexLock;
+    QAtomicInt indexDirty;
+    QPointer<QFileSystemWatcher> watcher;
 };
 
 UnityThemeIconProvider::UnityThemeIconProvider(const QString &themeName):
   QQuickImageProvider(QQuickImageProvider::Image)
 {
     theme = IconTheme::get(themeName);
+    // create the fallback theme as well, so its directories get watched
+    IconTheme::get(QStringLiteral("hicolor"));
 }
 
 QImage UnityThemeIconProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
@@ -22,10 +22,7 @@ PickerModelBase {
 
     function reset() {
         resetting = true;
-        clear();
-        for (var i = 0; i < date.daysInMonth(); i++) {
-            append({"day": i});
-        }
+        resetRange(0, date.daysInMonth());
     }
 
     function resetLimits(label, margin) {
@@ -41,16 +38,7 @@ PickerModelBase {
     }
 
     function syncModels() {
-        var newDaysCount = mainComponent.date.daysInMonth(mainComponent.year, mainComponent.month);
-        var modelCount = count;
-        var daysDiff = newDaysCount - modelCount;
-        if (daysDiff < 0) {
-            remove(modelCount + daysDiff, -daysDiff);
-        } else if (daysDiff > 0) {
-            for (var d = modelCount; d < modelCount + daysDiff; d++) {
-                append({"day": d});
-            }
-        }
+        resizeRange(mainComponent.date.daysInMonth(mainComponent.year, mainComponent.month));
     }
 
     function indexOf() {
@@ -71,16 +59,16 @@ PickerModelBase {
             return "";
         }
 
-        var thisDate = new Date(date);
-        thisDate.setDate(value + 1);
-
-        if (pickerWidth >= longFormatLimit) {
-            return Qt.formatDate(thisDate, "dd ") + mainComponent.locale.dayName(thisDate.getDay(), Locale.LongFormat);
-        }
-
-        if (pickerWidth >= shortFormatLimit) {
-            return Qt.formatDate(thisDate, "dd ") + mainComponent.locale.dayName(thisDate.getDay(), Locale.ShortFormat);
-        }
-        return Qt.formatDate(thisDate, "dd");
+        var format = (pickerWidth >= longFormatLimit) ? Locale.LongFormat
+            : ((pickerWidth >= shortFormatLimit) ? Locale.ShortFormat : Locale.NarrowFormat);
+        var key = [date.getFullYear(), date.getMonth(), value, format].join();
+        return cachedText(key, function() {
+            var thisDate = new Date(date);
+            thisDate.setDate(value + 1);
+            if (format == Locale.NarrowFormat) {
+                return Qt.formatDate(thisDate, "dd");
+            }
+            return Qt.formatDate(thisDate, "dd ") + mainComponent.locale.dayName(thisDate.getDay(), format);
+        });
     }
 }
@@ -18,18 +18,15 @@ import QtQuick 2.4
 import Ubuntu.Components 1.3
 
 PickerModelBase {
-    property int from
+    modulo: 24
     circular: count >= 24
 
     function reset() {
         resetting = true;
 
-        clear();
-        from = minimum.getHours();
+        var first = minimum.getHours();
         var distance = (!Date.prototype.isValid.call(maximum) || (minimum.daysTo(maximum) > 1)) ? 24 : minimum.hoursTo(maximum);
-        for (var i = 0; i < distance; i++) {
-            append({"hour": (from + i) % 24});
-        }
+        resetRange(first, distance);
 
         resetting = false;
     }
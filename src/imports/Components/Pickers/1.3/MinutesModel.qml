@@ -18,18 +18,15 @@ import QtQuick 2.4
 import Ubuntu.Components 1.3
 
 PickerModelBase {
-    property int from
+    modulo: 60
     circular: count >= 60
 
     function reset() {
         resetting = true;
 
-        clear();
-        from = minimum.getMinutes();
+        var first = minimum.getMinutes();
         var distance = (!maximum.isValid() || (minimum.daysTo(maximum) > 1) || (minimum.minutesTo(maximum) >= 60)) ? 60 : minimum.minutesTo(maximum);
-        for (var i = 0; i < distance; i++) {
-            append({"minute": (from + i) % 60});
-        }
+        resetRange(first, distance);
 
         resetting = false;
     }
@@ -19,26 +19,16 @@ import Ubuntu.Components 1.3
 
 PickerModelBase {
     circular: (count >= 11)
-
-    // local properties
-    property int from
+    modulo: 12
 
     function reset() {
         resetting = true;
-        clear();
-        var modelDate = new Date(date);
-        modelDate.setDate(1);
 
         // if maximum is invalid, we have full model (12 months to show)
         var distance, to;
         distance = to = maximum.isValid() ? minimum.monthsTo(maximum) : 11;
         if (to < 0 || to > 11) to = 11;
-        from = (to < 11) ? minimum.getMonth() : 0;
-        // fill the model
-        for (var i = from; i <= from + to; i++) {
-            modelDate.setMonth(i);
-            append({"month": modelDate.getMonth()});
-        }
+        resetRange((to < 11) ? minimum.getMonth() : 0, to + 1);
     }
 
     function resetLimits(label, margin) {
@@ -70,7 +60,7 @@ PickerModelBase {
         var fromDay = newDate.getDate();
         // move the day to the 1st of the month so we don't overflow when setting the month
         newDate.setDate(1);
-        newDate.setMonth(get(index).month);
+        newDate.setMonth(valueAt(index));
         var maxDays = newDate.daysInMonth();
         // check whether the original day would overflow
         // and trim to the mont's maximum date
@@ -82,17 +72,16 @@ PickerModelBase {
         if (!mainComponent || value === undefined) {
             return "";
         }
-        if (pickerWidth >= longFormatLimit) {
-            return mainComponent.locale.monthName(value, Locale.LongFormat);
-        }
-
-        if (pickerWidth >= shortFormatLimit) {
-            return mainComponent.locale.monthName(value, Locale.ShortFormat);
-        }
-
-        var thisDate = new Date(date);
-        thisDate.setDate(1);
-        thisDate.setMonth(value);
-        return Qt.formatDate(thisDate, "MM");
+        var format = (pickerWidth >= longFormatLimit) ? Locale.LongFormat
+            : ((pickerWidth >= shortFormatLimit) ? Locale.ShortFormat : Locale.NarrowFormat);
+        return cachedText([value, format].join(), function() {
+            if (format != Locale.NarrowFormat) {
+                return mainComponent.locale.monthName(value, format);
+            }
+            var thisDate = new Date(date);
+            thisDate.setDate(1);
+            thisDate.setMonth(value);
+            return Qt.formatDate(thisDate, "MM");
+        });
     }
 }
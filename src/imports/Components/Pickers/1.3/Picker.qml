@@ -421,8 +421,10 @@ StyledItem {
             }
         }
 
-        function updateView() {
-            if (!loader.isListView && loader.item.count === 2) {
+        function updateView(parent, first, last) {
+            // models may insert several rows at once, check whether the view got its second item
+            var count = loader.item.count;
+            if (!loader.isListView && count >= 2 && (count - (last - first + 1)) < 2) {
                 // currentItem gets set upon first flick or move when the model is empty
                 // at the time the component gets completed. Disable viewCompleted till
                 // we move the view so selectedIndex doesn't get altered
@@ -15,11 +15,13 @@
  */
 
 import QtQuick 2.4
+import Ubuntu.Components.Private 1.3
 
 /*
-  Base model type for DatePicker
+  Base model type for DatePicker. The rows are computed from the from, count and
+  modulo properties of the PickerModel, the model doesn't hold any per row data.
   */
-ListModel {
+PickerModel {
 
     /*
       Holds the picker instance, the component the model is attached to. Should
@@ -65,6 +67,7 @@ ListModel {
       The function completes the reset operation.
       */
     function resetCompleted() {
+        labelCache = {};
         resetting = false;
     }
 
@@ -107,6 +110,22 @@ ListModel {
         return "";
     }
 
+    /*
+      Returns the label cached under the key for the current locale, calling format()
+      to produce it on first use. Derivates use it in text() when building the label
+      involves Date objects and locale lookups.
+      */
+    function cachedText(key, format) {
+        key = mainComponent.locale.name + "|" + key;
+        var label = labelCache[key];
+        if (label === undefined) {
+            label = format();
+            labelCache[key] = label;
+        }
+        return label;
+    }
+    property var labelCache: ({})
+
     /*
       Readonly properties to the composit picker's date properties
       */
@@ -18,18 +18,15 @@ import QtQuick 2.4
 import Ubuntu.Components 1.3
 
 PickerModelBase {
-    property int from
+    modulo: 60
     circular: count >= 60
 
     function reset() {
         resetting = true;
 
-        clear();
-        from = minimum.getSeconds();
+        var first = minimum.getSeconds();
         var distance = (!maximum.isValid() || (minimum.daysTo(maximum) > 1) || (minimum.secondsTo(maximum) >= 60)) ? 59 : minimum.secondsTo(maximum);
-        for (var i = 0; i <= distance; i++) {
-            append({"seconds": (from + i) % 60});
-        }
+        resetRange(first, distance + 1);
 
         resetting = false;
     }
@@ -18,17 +18,15 @@ import QtQuick 2.4
 import Ubuntu.Components 1.3
 
 PickerModelBase {
-    // local properties
-    property int from
     circular: false
     autoExtend: !maximum.isValid()
 
     function reset() {
         resetting = true;
-        clear();
-        from = (minimum.getFullYear() <= 0) ? date.getFullYear() : minimum.getFullYear();
+        var first = (minimum.getFullYear() <= 0) ? date.getFullYear() : minimum.getFullYear();
         var to = (maximum < minimum) ? -1 : maximum.getFullYear();
-        extend(from, to - from);
+        resetRange(first, 0);
+        extend(first, to - first);
     }
 
     function resetLimits(label, margin) {
@@ -40,9 +38,7 @@ PickerModelBase {
         if (items === undefined || items < 0) {
             items = 50;
         }
-        for (var i = baseYear; i <= baseYear + items; i++) {
-            append({"modelData" : i});
-        }
+        resizeRange(baseYear + items - from + 1);
     }
 
     function indexOf() {
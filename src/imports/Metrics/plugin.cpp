@@ -33,6 +33,8 @@ class ApplicationMonitorWrapper : public QObject
                NOTIFY loggingFilterChanged)
     Q_PROPERTY(int processUpdateInterval READ processUpdateInterval
                WRITE setProcessUpdateInterval NOTIFY processUpdateIntervalChanged)
+    Q_PROPERTY(int frameSummaryUpdateInterval READ frameSummaryUpdateInterval
+               WRITE setFrameSummaryUpdateInterval NOTIFY frameSummaryUpdateIntervalChanged)
 
 public:
     ApplicationMonitorWrapper(QObject* parent = 0)
@@ -55,6 +57,7 @@ public:
         WindowEvent  = UMApplicationMonitor::WindowEvent,
         FrameEvent   = UMApplicationMonitor::FrameEvent,
         GenericEvent = UMApplicationMonitor::GenericEvent,
+        FrameSummaryEvent = UMApplicationMonitor::FrameSummaryEvent,
         AllEvents    = UMApplicationMonitor::AllEvents
     };
     Q_DECLARE_FLAGS(LoggingFilters, LoggingFilter)
@@ -79,6 +82,10 @@ public:
         return m_applicationMonitor->updateInterval(UMEvent::Process); }
     void setProcessUpdateInterval(int interval) {
         m_applicationMonitor->setUpdateInterval(UMEvent::Process, interval); }
+    int frameSummaryUpdateInterval() const {
+        return m_applicationMonitor->updateInterval(UMEvent::FrameSummary); }
+    void setFrameSummaryUpdateInterval(int interval) {
+        m_applicationMonitor->setUpdateInterval(UMEvent::FrameSummary, interval); }
 
     Q_INVOKABLE bool logEvent(Event event) {
         return m_applicationMonitor->logEvent(static_cast<UMApplicationMonitor::Event>(event)); }
@@ -88,12 +95,15 @@ Q_SIGNALS:
     void loggingChanged();
     void loggingFilterChanged();
     void processUpdateIntervalChanged();
+    void frameSummaryUpdateIntervalChanged();
 
 private Q_SLOTS:
     void updateIntervalChanged(UMEvent::Type type)
     {
         if (type == UMEvent::Process) {
             Q_EMIT processUpdateIntervalChanged();
+        } else if (type == UMEvent::FrameSummary) {
+            Q_EMIT frameSummaryUpdateIntervalChanged();
         }
     }
 
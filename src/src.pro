@@ -23,6 +23,13 @@ linux {
     SUBDIRS += src_metrics_lttng_plugin
 }
 
+# Tools
+
+src_metrics_converter_tool.subdir = UbuntuMetrics/tools/converter
+src_metrics_converter_tool.target = sub-metrics-converter-tool
+src_metrics_converter_tool.depends = sub-metrics-lib
+SUBDIRS += src_metrics_converter_tool
+
 # QML modules
 
 src_metrics_module.subdir = imports/Metrics
@@ -17,7 +17,10 @@
  */
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
 #include <QtCore/QString>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QTextCodec>
 #include <QtCore/QTimeZone>
 #include <QtQml/QQmlEngine>
@@ -588,6 +591,75 @@ private Q_SLOTS:
         // check the tags
         QVERIFY(AlarmManager::instance().verifyChange(&alarm, AlarmManager::Enabled, enabled));
     }
+
+    void test_refresh_keeps_unchanged_rows()
+    {
+        UCAlarm alarm(QDateTime::currentDateTime().addDays(1), "test_refresh_keeps_unchanged_rows");
+        alarm.save();
+        waitForInsert();
+        QVERIFY(containsAlarm(&alarm));
+
+        UCAlarmModel model;
+        QSignalSpy reset(&model, SIGNAL(modelAboutToBeReset()));
+        QSignalSpy inserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+        QSignalSpy removed(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+        QSignalSpy changed(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+        const int count = model.count();
+        QVERIFY(count > 0);
+
+        syncFetch();
+        QCOMPARE(reset.count(), 0);
+        QCOMPARE(inserted.count(), 0);
+        QCOMPARE(removed.count(), 0);
+        QCOMPARE(changed.count(), 0);
+        QCOMPARE(model.count(), count);
+    }
+
+    void test_journaled_storage()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QJsonObject first;
+        first["id"] = QString("first");
+        first["message"] = QString("first alarm");
+        QJsonObject second;
+        second["id"] = QString("second");
+        second["message"] = QString("second alarm");
+        QJsonObject third;
+        third["id"] = QString("third");
+        third["message"] = QString("third alarm");
+
+        AlarmStorage storage(dir.path());
+        storage.reset(QList<QJsonObject>() << first << second);
+        second["message"] = QString("second alarm updated");
+        storage.save(second);
+        storage.remove("first");
+        storage.save(third);
+        storage.commit();
+        QCOMPARE(storage.journalSize(), 3);
+        storage.waitForDone();
+
+        // replay the journal on the database
+        QList<QJsonObject> expected;
+        expected << second << third;
+        AlarmStorage loaded(dir.path());
+        QCOMPARE(loaded.load(), expected);
+        QCOMPARE(loaded.journalSize(), 3);
+
+        // a record not completely written is ignored
+        QFile journal(dir.path() + "/alarms.journal");
+        QVERIFY(journal.open(QFile::WriteOnly | QFile::Append));
+        journal.write("{\"id\":\"second\",\"operation\":\"rem");
+        journal.close();
+        QCOMPARE(loaded.load(), expected);
+
+        // compaction removes the journal
+        loaded.reset(expected);
+        loaded.waitForDone();
+        QVERIFY(!journal.exists());
+        QCOMPARE(loaded.load(), expected);
+        QCOMPARE(loaded.journalSize(), 0);
+    }
 };
 
 QTEST_MAIN(tst_UCAlarms)
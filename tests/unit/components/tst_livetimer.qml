@@ -19,6 +19,7 @@ import QtTest 1.0
 import Ubuntu.Components 1.3
 
 TestCase {
+    id: testCase
     name: "LiveTimer"
 
     function test_0_defaults() {
@@ -45,7 +46,45 @@ TestCase {
         compare(liveTimer.relativeTime, new Date(2015, 0, 0, 0, 0, 0, 0), "Can set/get relativeTime")
     }
 
+    property int triggeredCount: 0
+
+    function test_many_timers_trigger() {
+        for (var i = 0; i < timers.count; i++) {
+            timers.itemAt(i).triggered = false;
+        }
+        triggeredCount = 0;
+        timers.frequency = LiveTimer.Second;
+        tryCompare(testCase, "triggeredCount", timers.count, 3000, "All the timers should trigger");
+        timers.frequency = LiveTimer.Disabled;
+    }
+
+    function benchmark_register_many_timers() {
+        // every frequency change unregisters and registers the timer again
+        var frequencies = [LiveTimer.Second, LiveTimer.Minute, LiveTimer.Hour, LiveTimer.Disabled];
+        for (var f = 0; f < frequencies.length; f++) {
+            timers.frequency = frequencies[f];
+        }
+    }
+
     LiveTimer {
         id: liveTimer
     }
+
+    Repeater {
+        id: timers
+        property int frequency: LiveTimer.Disabled
+        model: 1000
+        delegate: Item {
+            property bool triggered: false
+            LiveTimer {
+                frequency: timers.frequency
+                onTrigger: {
+                    if (!parent.triggered) {
+                        parent.triggered = true;
+                        testCase.triggeredCount++;
+                    }
+                }
+            }
+        }
+    }
 }
@@ -79,6 +79,40 @@ TestCase {
         filter.pattern: /bar/i
     }
 
+    ListModel {
+        id: names
+        ListElement { name: "Anna"; age: 31 }
+        ListElement { name: "Hannah"; age: 25 }
+        ListElement { name: "Joanna"; age: 47 }
+        ListElement { name: "Johan"; age: 18 }
+    }
+
+    SortFilterModel {
+        id: search
+        model: names
+        sort.property: "age"
+        filter.property: "name"
+    }
+
+    ListModel {
+        id: growing
+    }
+
+    ListModel {
+        id: many
+    }
+
+    SortFilterModel {
+        id: manySearch
+        model: many
+        filter.property: "name"
+    }
+
+    SortFilterModel {
+        id: growingRoles
+        model: growing
+    }
+
     function test_passthrough() {
         compare(unmodified.count, things.count)
     }
@@ -119,6 +153,35 @@ TestCase {
         compare(alphabetic.get(2).alpha, "cow")
     }
 
+    function test_get_range() {
+        var rows = alphabetic.getRange(0, alphabetic.count)
+        compare(rows.length, 3)
+        for (var i = 0; i < rows.length; i++) {
+            compare(rows[i].alpha, alphabetic.get(i).alpha)
+            compare(rows[i].foo, alphabetic.get(i).foo)
+            compare(rows[i].num, alphabetic.get(i).num)
+        }
+        // clamped to the rows of the model
+        rows = alphabetic.getRange(1, 10)
+        compare(rows.length, 2)
+        compare(rows[0].alpha, "bee")
+        compare(alphabetic.getRange(-1, 1)[0].alpha, "ant")
+        compare(alphabetic.getRange(3, 1).length, 0)
+        compare(alphabetic.getRange(0, -1).length, 0)
+        compare(alphabetic.getRange(1, 2147483647).length, 2)
+        compare(alphabetic.get(3).alpha, undefined)
+    }
+
+    function test_get_added_roles() {
+        growing.append({ name: "first" })
+        compare(growingRoles.get(0).name, "first")
+        // the ListModel gains a role
+        growing.append({ name: "second", extra: 1 })
+        compare(growingRoles.get(1).extra, 1)
+        compare(growingRoles.getRange(0, 2)[1].extra, 1)
+        growing.clear()
+    }
+
     function test_filter() {
         // Default is an empty pattern
         compare(unmodified.filter.pattern, RegExp())
@@ -131,4 +194,78 @@ TestCase {
     function test_case_sensitivity() {
         compare(caseSensitivity.get(0).foo, "Bar")
     }
+
+    function test_narrowing_filter() {
+        search.filter.pattern = /an/i
+        compare(search.count, 4)
+        search.filter.pattern = /ann/i
+        compare(search.count, 3)
+        search.filter.pattern = /anna/i
+        compare(search.count, 3)
+        compare(search.get(0).name, "Hannah")
+        search.filter.pattern = /annah/i
+        compare(search.count, 1)
+        compare(search.get(0).name, "Hannah")
+        // widening again must bring back the rows filtered out
+        search.filter.pattern = /an/i
+        compare(search.count, 4)
+        // not a plain string, matched on every row
+        search.filter.pattern = /^jo/i
+        compare(search.count, 2)
+        search.filter.pattern = /./
+        compare(search.count, 4)
+        search.filter.pattern = RegExp()
+        compare(search.count, 4)
+    }
+
+    function test_narrowing_filter_many_rows() {
+        // above the row count filtered in parallel chunks
+        for (var i = 0; i < 10000; i++) {
+            many.append({ name: "row " + i });
+        }
+        function expectedCount(regExp) {
+            var result = 0;
+            for (var i = 0; i < many.count; i++) {
+                if (regExp.test(many.get(i).name)) {
+                    result++;
+                }
+            }
+            return result;
+        }
+        var patterns = [/7/, /77/, /777/, /7/, /^row 9/, /./];
+        for (var p = 0; p < patterns.length; p++) {
+            manySearch.filter.pattern = patterns[p];
+            compare(manySearch.count, expectedCount(patterns[p]), "Pattern " + patterns[p]);
+        }
+        manySearch.filter.pattern = /9999/
+        compare(manySearch.count, 1)
+        compare(manySearch.get(0).name, "row 9999")
+        manySearch.filter.pattern = RegExp()
+        many.clear()
+    }
+
+    function test_filter_and_sort_follow_source_changes() {
+        search.filter.pattern = /ann/i
+        compare(search.count, 3)
+        compare(search.get(0).name, "Hannah")
+
+        names.append({ name: "Annabel", age: 5 })
+        compare(search.count, 4)
+        compare(search.get(0).name, "Annabel")
+
+        names.setProperty(1, "age", 50)
+        compare(search.get(3).name, "Hannah")
+
+        names.setProperty(1, "name", "Hanna")
+        compare(search.count, 4)
+        names.setProperty(1, "name", "Hans")
+        compare(search.count, 3)
+
+        names.remove(4)
+        names.setProperty(1, "name", "Hannah")
+        names.setProperty(1, "age", 25)
+        compare(search.count, 3)
+        compare(search.get(0).name, "Hannah")
+        search.filter.pattern = RegExp()
+    }
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.0
+import QtTest 1.0
+import Ubuntu.Components 1.3
+
+TestCase {
+    name: "SortFilterModelBenchmark"
+
+    property int rowCount: 10000
+
+    ListModel {
+        id: rows
+    }
+
+    SortFilterModel {
+        id: sorted
+        model: rows
+        sort.property: "title"
+    }
+
+    function initTestCase() {
+        for (var i = 0; i < rowCount; i++) {
+            rows.append({ title: "Title " + ((i * 7919) % rowCount), subtitle: "Subtitle " + i,
+                          value: i });
+        }
+        compare(sorted.count, rowCount);
+    }
+
+    function benchmark_get() {
+        var sum = 0;
+        for (var i = 0; i < sorted.count; i++) {
+            sum += sorted.get(i).value;
+        }
+        compare(sum, rowCount * (rowCount - 1) / 2);
+    }
+
+    function benchmark_getRange() {
+        var sum = 0;
+        var range = sorted.getRange(0, sorted.count);
+        for (var i = 0; i < range.length; i++) {
+            sum += range[i].value;
+        }
+        compare(sum, rowCount * (rowCount - 1) / 2);
+    }
+}
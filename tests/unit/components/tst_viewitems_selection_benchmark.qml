@@ -0,0 +1,65 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.0
+import QtTest 1.0
+import Ubuntu.Components 1.3
+
+TestCase {
+    name: "ViewItemsSelectionBenchmark"
+    width: 400
+    height: 400
+    when: windowShown
+
+    property int rowCount: 10000
+
+    ListView {
+        id: listView
+        anchors.fill: parent
+        model: rowCount
+        delegate: ListItem {
+            objectName: "listItem" + index
+        }
+    }
+
+    function init() {
+        listView.ViewItems.selectedIndices = [];
+    }
+
+    function benchmark_selectAll() {
+        listView.ViewItems.selectAll();
+        compare(listView.ViewItems.selectedIndices.length, rowCount);
+        listView.ViewItems.selectedIndices = [];
+    }
+
+    function benchmark_selectRange_every_other_hundred() {
+        for (var i = 0; i < rowCount; i += 200) {
+            listView.ViewItems.selectRange(i, i + 99);
+        }
+        compare(listView.ViewItems.selectedIndices.length, rowCount / 2);
+        listView.ViewItems.selectedIndices = [];
+    }
+
+    function benchmark_set_selectedIndices() {
+        var indices = [];
+        for (var i = 0; i < rowCount; i++) {
+            indices.push(rowCount - 1 - i);
+        }
+        listView.ViewItems.selectedIndices = indices;
+        compare(listView.ViewItems.selectedIndices.length, rowCount);
+        listView.ViewItems.selectedIndices = [];
+    }
+}
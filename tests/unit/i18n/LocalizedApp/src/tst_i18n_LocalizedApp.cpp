@@ -193,6 +193,32 @@ private Q_SLOTS:
         QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Contar los gatitos"));
         QCOMPARE(i18n->ctr(QString("All Cats"), QString("All")), QString("Cada"));
     }
+
+    void testCase_TranslationCache()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        i18n->setLanguage("C");
+        i18n->setLanguage("en_US.utf8");
+
+        UbuntuI18n::CacheStatistics before = i18n->cacheStatistics();
+        QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Contar los gatitos"));
+        QCOMPARE(i18n->cacheStatistics().misses, before.misses + 1);
+        QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Contar los gatitos"));
+        QCOMPARE(i18n->cacheStatistics().hits, before.hits + 1);
+
+        // contexts and domains are cached apart
+        before = i18n->cacheStatistics();
+        QCOMPARE(i18n->ctr(QString("All Cats"), QString("All")), QString("Cada"));
+        QCOMPARE(i18n->dtr(QString("ubuntu-ui-toolkit"), QString("Count the kittens")),
+                 QString("Count the kittens"));
+        QCOMPARE(i18n->cacheStatistics().misses, before.misses + 2);
+        QCOMPARE(i18n->cacheStatistics().count, before.count + 2);
+
+        // translations are looked up again in the new language
+        i18n->setLanguage("C");
+        QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Count the kittens"));
+        QCOMPARE(i18n->ctr(QString("All Cats"), QString("All")), QString("All"));
+    }
 };
 
 // The C++ equivalent of QTEST_MAIN(tst_I18n_LocalizedApp) with added initialization
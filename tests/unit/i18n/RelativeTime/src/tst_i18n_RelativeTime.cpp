@@ -188,6 +188,22 @@ private Q_SLOTS:
         QCOMPARE(i18n->relativeDateTime(QDateTime::currentDateTime().addSecs(-600)), QString("tr:10 minutes ago"));
         QCOMPARE(i18n->relativeDateTime(QDateTime::currentDateTime().addSecs(600)), QString("tr:10 minutes"));
     }
+
+    // one tick of a list of timestamps spread from within the hour to far back
+    void benchmark_RelativeTime()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        QDateTime now(QDateTime::currentDateTime());
+        QList<QDateTime> timestamps;
+        for (int i = 0; i < 1000; i++) {
+            timestamps.append(now.addSecs(-i * i * 60));
+        }
+        QBENCHMARK {
+            Q_FOREACH(const QDateTime &timestamp, timestamps) {
+                i18n->relativeDateTime(timestamp);
+            }
+        }
+    }
 };
 
 // The C++ equivalent of QTEST_MAIN(tst_I18n_RelativeTime) with added initialization
@@ -93,6 +93,33 @@ private Q_SLOTS:
         QVERIFY(!i.isNull());
         QCOMPARE(QColor(i.pixel(0,0)), QColor(Qt::black));
     }
+
+    void test_indexUpdatedOnChange()
+    {
+        QTemporaryDir dataDir;
+        QVERIFY(dataDir.isValid());
+        const QString themeDir = dataDir.path() + "/icons/mockTempTheme";
+        QVERIFY(QDir().mkpath(themeDir + "/apps/512"));
+        QFile index(themeDir + "/index.theme");
+        QVERIFY(index.open(QIODevice::WriteOnly | QIODevice::Text));
+        index.write("[Icon Theme]\nName=MockTempTheme\nDirectories=apps/512\n\n"
+                    "[apps/512]\nSize=512\nContext=Applications\nType=Fixed\n");
+        index.close();
+        qputenv("XDG_DATA_DIRS", QByteArray(SRCDIR) + ":" + QFile::encodeName(dataDir.path()));
+
+        QSize returnedSize;
+        UnityThemeIconProvider provider("mockTempTheme");
+        QImage i = provider.requestImage("myapp3", &returnedSize, QSize(-1, -1));
+        QVERIFY(i.isNull());
+
+        // the icon is found once the theme directory change is noticed
+        QVERIFY(QFile::copy(SRCDIR "icons/hicolor/apps/512/myapp2.png",
+                            themeDir + "/apps/512/myapp3.png"));
+        QTRY_VERIFY(!provider.requestImage("myapp3", &returnedSize, QSize(-1, -1)).isNull());
+        QCOMPARE(returnedSize, QSize(512, 512));
+
+        qputenv("XDG_DATA_DIRS", SRCDIR);
+    }
 };
 
 QTEST_MAIN(tst_IconProvider)
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
+#include <QtTest/QtTest>
+#include <UbuntuToolkit/private/livetimer_p_p.h>
+
+UT_USE_NAMESPACE
+
+class tst_LiveTimer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_LiveTimer() {}
+
+private:
+    QList<LiveTimer*> timers;
+    QSet<LiveTimer*> triggered;
+
+private Q_SLOTS:
+    void cleanup()
+    {
+        qDeleteAll(timers);
+        timers.clear();
+        triggered.clear();
+        SharedLiveTimer::instance().setDispatchBudget(0);
+    }
+
+    void test_budgeted_dispatch()
+    {
+        const int count = 500;
+        for (int i = 0; i < count; i++) {
+            LiveTimer *timer = new LiveTimer;
+            timer->setFrequency(LiveTimer::Second);
+            // slow triggers, so that the budget gets spent
+            connect(timer, &LiveTimer::trigger, [this, timer]() {
+                triggered.insert(timer);
+                QElapsedTimer busy;
+                busy.start();
+                while (busy.nsecsElapsed() < 100000) {}
+            });
+            timers.append(timer);
+        }
+
+        SharedLiveTimer &shared = SharedLiveTimer::instance();
+        shared.setDispatchBudget(1);
+        shared.tick(QDateTime::currentDateTime().addSecs(1));
+        QVERIFY(triggered.count() > 0);
+        QVERIFY2(triggered.count() < count, "The triggers should yield to the event loop");
+
+        // the last timer is still queued, it must be skipped once destroyed
+        LiveTimer *queued = timers.takeLast();
+        QVERIFY(!triggered.contains(queued));
+        delete queued;
+        QTRY_COMPARE(triggered.count(), count - 1);
+    }
+
+    void test_relative_buckets()
+    {
+        const QDate today(2017, 3, 15);
+        QDateTime now(today, QTime(10, 58, 30));
+
+        // "30 minutes ago" and an absolute time of today
+        LiveTimer *withinHour = new LiveTimer;
+        withinHour->setRelativeTime(QDateTime(today, QTime(10, 28, 15)));
+        withinHour->setFrequency(LiveTimer::Relative);
+        timers.append(withinHour);
+        LiveTimer *earlierToday = new LiveTimer;
+        earlierToday->setRelativeTime(QDateTime(today, QTime(6, 0, 0)));
+        earlierToday->setFrequency(LiveTimer::Relative);
+        timers.append(earlierToday);
+
+        SharedLiveTimer &shared = SharedLiveTimer::instance();
+        // registration used the real time, sync the buckets with the test time
+        shared.tick(now);
+        QSignalSpy withinHourSpy(withinHour, SIGNAL(trigger()));
+        QSignalSpy earlierTodaySpy(earlierToday, SIGNAL(trigger()));
+        QCOMPARE(withinHour->effectiveFrequency(), LiveTimer::Minute);
+        QCOMPARE(earlierToday->effectiveFrequency(), LiveTimer::Hour);
+
+        // a second tick does not change the minutes
+        shared.tick(now.addSecs(1));
+        QCOMPARE(withinHourSpy.count(), 0);
+        QCOMPARE(earlierTodaySpy.count(), 0);
+
+        // minute boundary
+        shared.tick(QDateTime(today, QTime(10, 59, 0)));
+        QCOMPARE(withinHourSpy.count(), 1);
+        QCOMPARE(earlierTodaySpy.count(), 0);
+
+        // hour boundary, the text of today stays the same
+        shared.tick(QDateTime(today, QTime(11, 0, 0)));
+        QCOMPARE(withinHourSpy.count(), 2);
+        QCOMPARE(earlierTodaySpy.count(), 0);
+
+        // the minutes keep on changing after the hour boundary
+        shared.tick(QDateTime(today, QTime(11, 1, 0)));
+        QCOMPARE(withinHourSpy.count(), 3);
+        QCOMPARE(earlierTodaySpy.count(), 0);
+    }
+};
+
+QTEST_MAIN(tst_LiveTimer)
+
+#include "tst_livetimer.moc"
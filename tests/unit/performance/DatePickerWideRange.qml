@@ -0,0 +1,36 @@
+/*
+ * Copyright 2017 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+import Ubuntu.Components.Pickers 1.3
+
+Column {
+    width: 800
+    height: 600
+
+    DatePicker {
+        mode: "Years|Months|Days"
+        minimum: new Date(1900, 0, 1)
+        maximum: new Date(2100, 11, 31)
+        date: new Date(2000, 5, 15)
+    }
+
+    DatePicker {
+        mode: "Hours|Minutes|Seconds"
+        date: new Date(2000, 5, 15, 12, 30, 30)
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+// Shapes of different colors and sizes sharing the same radius and aspect, the scene graph
+// renderer should be able to merge them in a few draw calls.
+Grid {
+    width: 800
+    height: 600
+    rows: 16
+    columns: 16
+    Repeater {
+        model: 16*16
+        Item {
+            width: units.gu(6)
+            height: units.gu(6)
+            UbuntuShape {
+                width: units.gu(2 + index % 4)
+                height: units.gu(2 + index % 3)
+                backgroundColor: Qt.rgba((index % 16) / 16, (index % 7) / 7, 0.5, 1.0)
+            }
+        }
+    }
+}
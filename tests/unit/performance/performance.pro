@@ -45,4 +45,8 @@ OTHER_FILES += \
     ListOfListItemLayout_complex2.qml \
     ListOfListItemLayout_labelsOnly.qml \
     ListOfScrollbars_1_3.qml \
-    ListOfScrollView_bothScrollbars_1_3.qml
+    ListOfScrollView_bothScrollbars_1_3.qml \
+    ThemedListItemList13.qml \
+    Button13Grid.qml \
+    VaryingUbuntuShapeGrid.qml \
+    DatePickerWideRange.qml
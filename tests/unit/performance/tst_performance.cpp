@@ -79,6 +79,9 @@ private Q_SLOTS:
         QTest::newRow("subtheming, change mid item") << "Styling.qml" << QUrl("Ubuntu.Components.Themes.SuruDark");
         QTest::newRow("Palette configuration of one color") << "PaletteConfigurationOneColor.qml" << QUrl("Ubuntu.Components.Themes.SuruDark");
         QTest::newRow("Palette configuration of all colors") << "PaletteConfigurationAllColors.qml" << QUrl("Ubuntu.Components.Themes.SuruDark");
+        // style URLs are resolved once per theme, a theme change resolves them again
+        QTest::newRow("style lookup, list of 500 ListItem 1.3") << "ThemedListItemList13.qml" << QUrl();
+        QTest::newRow("style lookup, list of 500 ListItem 1.3, with theme change") << "ThemedListItemList13.qml" << QUrl("Ubuntu.Components.Themes.SuruDark");
     }
     void benchmark_theming()
     {
@@ -110,7 +113,10 @@ private Q_SLOTS:
         QTest::newRow("grid with Label 1.3") << "LabelGrid13.qml" << QUrl();
         QTest::newRow("grid with UbuntuShape") << "UbuntuShapeGrid.qml" << QUrl();
         QTest::newRow("grid with UbuntuShapePair") << "PairOfUbuntuShapeGrid.qml" << QUrl();
+        QTest::newRow("grid with UbuntuShape of varying colors and sizes") << "VaryingUbuntuShapeGrid.qml" << QUrl();
         QTest::newRow("grid with Button") << "ButtonGrid.qml" << QUrl();
+        // all the Buttons share the style component compiled by the theme
+        QTest::newRow("grid with Button 1.3") << "Button13Grid.qml" << QUrl();
         QTest::newRow("grid with Slider") << "SliderGrid.qml" << QUrl();
         QTest::newRow("list with QtQuick Item") << "ItemList.qml" << QUrl();
         QTest::newRow("list with new ListItem") << "ListItemList.qml" << QUrl();
@@ -133,6 +139,7 @@ private Q_SLOTS:
         // disable this test as it takes >20 seconds. Kept still for measurements to be done during development
         //        QTest::newRow("list with ListItems.Base (one icon, one label and one chevron)") << "ListItemsBaseList.qml" << QUrl();
         QTest::newRow("single MainView") << "MainView.qml" << QUrl();
+        QTest::newRow("DatePickers spanning two centuries and a full day") << "DatePickerWideRange.qml" << QUrl();
     }
 
     void benchmark_GridOfComponents()
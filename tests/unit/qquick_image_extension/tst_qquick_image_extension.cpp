@@ -28,10 +28,12 @@
 
 UT_USE_NAMESPACE
 
-unsigned int numberOfTemporarySciFiles() {
+QTemporaryDir cacheDir;
+
+unsigned int numberOfCachedSciFiles() {
     QStringList nameFilters;
     nameFilters << "*.sci";
-    return QDir::temp().entryList(nameFilters, QDir::Files).count();
+    return QDir(cacheDir.path() + "/ubuntu-ui-toolkit/sci").entryList(nameFilters, QDir::Files).count();
 }
 
 int nFaces = 0;
@@ -57,6 +59,13 @@ private:
 
 private Q_SLOTS:
 
+    void initTestCase()
+    {
+        // rewritten .sci files go to the user cache directory
+        QVERIFY(cacheDir.isValid());
+        qputenv("XDG_CACHE_HOME", QFile::encodeName(cacheDir.path()));
+    }
+
     void init()
     {
         engine = new QQmlEngine;
@@ -115,30 +124,60 @@ private Q_SLOTS:
 
     void cachingOfRewrittenSciFiles() {
         /* This tests an internal implementation detail of UCQQuickImageExtension,
-           namely making sure that only one temporary rewritten .sci file is
-           created for each source .sci file.
+           namely making sure that only one rewritten .sci file is created for each
+           source .sci file and scale, and that it is kept in the cache directory.
         */
         QQuickImageBase baseImage;
         UCQQuickImageExtension* image1 = new UCQQuickImageExtension(&baseImage);
         UCQQuickImageExtension* image2 = new UCQQuickImageExtension(&baseImage);
         QUrl sciFileUrl = QUrl::fromLocalFile("./data/test.sci");
 
-        unsigned int initialNumberOfSciFiles = numberOfTemporarySciFiles();
+        unsigned int initialNumberOfSciFiles = numberOfCachedSciFiles();
 
         image1->setSource(sciFileUrl);
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+        QCOMPARE(numberOfCachedSciFiles(), initialNumberOfSciFiles + 1);
 
         image2->setSource(sciFileUrl);
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+        QCOMPARE(numberOfCachedSciFiles(), initialNumberOfSciFiles + 1);
 
-        delete image1;
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
-
-        /* The temporary files will be deleted when the cache is destroyed when
-           the application exits.
+        /* The rewritten files outlive the images and the application, so
+           the next runs do not need to rewrite them.
         */
+        delete image1;
         delete image2;
-        QCOMPARE(numberOfTemporarySciFiles(), initialNumberOfSciFiles + 1);
+        QCOMPARE(numberOfCachedSciFiles(), initialNumberOfSciFiles + 1);
+    }
+
+    void rewrittenSciFileKeyedOnScale() {
+        const QString sciFilePath = QFileInfo("./data/test@18.sci").absoluteFilePath();
+        const QString half = UCQQuickImageExtension::rewrittenSciFile(sciFilePath, "0.5");
+        QVERIFY(!half.isEmpty());
+        QVERIFY(half.startsWith(UCQQuickImageExtension::sciCacheDirectory()));
+        QCOMPARE(UCQQuickImageExtension::rewrittenSciFile(sciFilePath, "0.5"), half);
+
+        const QString quarter = UCQQuickImageExtension::rewrittenSciFile(sciFilePath, "0.25");
+        QVERIFY(!quarter.isEmpty());
+        QVERIFY(quarter != half);
+
+        QCOMPARE(UCQQuickImageExtension::rewrittenSciFile("./data/missing.sci", "0.5"), QString());
+    }
+
+    void rewrittenSciFilesOfFormerVersionsPruned() {
+        const QString sciFilePath = QFileInfo("./data/test@18.sci").absoluteFilePath();
+        const QString current = UCQQuickImageExtension::rewrittenSciFile(sciFilePath, "2");
+        QVERIFY(!current.isEmpty());
+
+        // a file rewritten from an older modification time of the same .sci file
+        const QString sourcePrefix = QFileInfo(current).fileName().section('-', 0, 0);
+        QFile stale(UCQQuickImageExtension::sciCacheDirectory() + sourcePrefix + "-0-32.sci");
+        QVERIFY(stale.open(QIODevice::WriteOnly));
+        stale.close();
+
+        const QString other = UCQQuickImageExtension::rewrittenSciFile(sciFilePath, "3");
+        QVERIFY(!other.isEmpty());
+        QVERIFY(!stale.exists());
+        QVERIFY(QFile::exists(current));
+        QVERIFY(QFile::exists(other));
     }
 
     void onlyOneStatRepeatedImage() {
@@ -93,6 +93,47 @@ private Q_SLOTS:
         QCOMPARE(size, returnedSize);
         QCOMPARE(result.size(), resultSize);
     }
+
+    void cachesDecodedImages() {
+        UCScalingImageProvider provider;
+        QSize size;
+        const QString id("0.5/" + QDir::currentPath() + QDir::separator() + "input.png");
+
+        QImage first = provider.requestImage(id, &size, QSize());
+        QImage second = provider.requestImage(id, &size, QSize());
+        QCOMPARE(second, first);
+        QCOMPARE(size, first.size());
+
+        UCScalingImageProvider::Statistics statistics = provider.statistics();
+        QCOMPARE(statistics.misses, quint64(1));
+        QCOMPARE(statistics.hits, quint64(1));
+        QCOMPARE(statistics.count, 1);
+        QCOMPARE(statistics.bytes, first.bytesPerLine() * first.height());
+
+        // a different requested size is decoded again
+        provider.requestImage(id, &size, QSize(10, 10));
+        QCOMPARE(provider.statistics().misses, quint64(2));
+        QCOMPARE(provider.statistics().count, 2);
+
+        // nothing is kept when the cache is smaller than the image
+        provider.clearCache();
+        provider.setCacheSize(1);
+        provider.requestImage(id, &size, QSize());
+        QCOMPARE(provider.statistics().count, 0);
+    }
+
+    void asynchronousResponse() {
+        UCScalingImageProvider provider;
+        QScopedPointer<QQuickImageResponse> response(provider.requestImageResponse(
+            "0.5/" + QDir::currentPath() + QDir::separator() + "input.png", QSize()));
+        // the image may be ready before any signal spy could be connected, and there is
+        // no texture factory until it is decoded
+        auto image = [&response]() {
+            QScopedPointer<QQuickTextureFactory> factory(response->textureFactory());
+            return factory ? factory->image() : QImage();
+        };
+        QTRY_COMPARE(image(), QImage("scaled_half.png"));
+    }
 };
 
 QTEST_MAIN(tst_UCScalingImageProvider)
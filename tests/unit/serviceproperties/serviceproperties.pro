@@ -1,8 +1,11 @@
 include(../test-include-x11.pri)
+QT += dbus
 SOURCES += \
     tst_serviceproperties.cpp
 
 OTHER_FILES += \
     IncomingCallVibrateWatcher.qml \
     InvalidPropertyWatcher.qml \
-    InvalidPropertyWatcher2.qml
+    InvalidPropertyWatcher2.qml \
+    SessionServiceWatcher.qml \
+    SessionInvalidPropertyWatcher.qml
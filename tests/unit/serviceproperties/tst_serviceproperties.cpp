@@ -16,6 +16,10 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QString>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusObjectPath>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 #include <UbuntuToolkit/private/ucserviceproperties_p_p.h>
@@ -24,6 +28,42 @@
 
 UT_USE_NAMESPACE
 
+static const QString mockService = QStringLiteral("com.ubuntu.test.ServiceProperties");
+
+// Stand-in for the accounts service, registered on the session bus of the test.
+class MockAccounts : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.ubuntu.test.ServiceProperties")
+public:
+    MockAccounts(QObject *parent = 0) : QObject(parent) {}
+
+public Q_SLOTS:
+    QDBusObjectPath FindUserById(qlonglong)
+    {
+        return QDBusObjectPath(QStringLiteral("/com/ubuntu/test/ServiceProperties/User"));
+    }
+};
+
+class MockUser : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.ubuntu.test.ServiceProperties.Sound")
+    Q_PROPERTY(bool IncomingCallVibrate READ incomingCallVibrate)
+    Q_PROPERTY(QString RingtoneName READ ringtoneName)
+public:
+    MockUser(QObject *parent = 0) : QObject(parent) {}
+
+    bool incomingCallVibrate() const
+    {
+        return false;
+    }
+    QString ringtoneName() const
+    {
+        return QStringLiteral("Marimba");
+    }
+};
+
 class tst_ServiceProperties : public QObject
 {
     Q_OBJECT
@@ -34,6 +74,16 @@ public:
 private:
 
     QString error;
+    QString sessionError;
+    MockAccounts accounts;
+    MockUser user;
+
+    UCServiceProperties *createSessionWatcher(QQmlEngine *engine, const QString &fileName)
+    {
+        engine->addImportPath(QDir(UBUNTU_QML_IMPORT_PATH).absolutePath());
+        QQmlComponent component(engine, QUrl::fromLocalFile(fileName));
+        return qobject_cast<UCServiceProperties*>(component.create());
+    }
 
     // FIXME use UbuntuTestCase::ignoreWaring in Vivid
     void ignoreWarning(const QString& fileName, uint line, uint column, const QString& message, uint occurences=1)
@@ -50,6 +100,17 @@ private Q_SLOTS:
 
     void initTestCase()
     {
+        // the mock service lives on the private session bus set up by the test runner
+        QDBusConnection session = QDBusConnection::sessionBus();
+        if (!session.isConnected()
+            || !session.registerService(mockService)
+            || !session.registerObject(QStringLiteral("/com/ubuntu/test/ServiceProperties"),
+                                       &accounts, QDBusConnection::ExportAllSlots)
+            || !session.registerObject(QStringLiteral("/com/ubuntu/test/ServiceProperties/User"),
+                                       &user, QDBusConnection::ExportAllProperties)) {
+            sessionError = "Skip test: cannot register the mock service on the session bus";
+        }
+
         // check if the connection is possible, otherwise we must skip all tests
         QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("IncomingCallVibrateWatcher.qml"));
         UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
@@ -78,6 +139,7 @@ private Q_SLOTS:
         QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("IncomingCallVibrateWatcher.qml"));
         UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
         QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
 
         bool backup = watcher->property("incomingCallVibrate").toBool();
         UCServicePropertiesPrivate *pWatcher = UCServicePropertiesPrivate::get(watcher);
@@ -123,8 +185,8 @@ private Q_SLOTS:
         QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("InvalidPropertyWatcher.qml"));
         UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
         QVERIFY(watcher);
-        // error should contain the warning
-        QCOMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
+        // error should contain the warning once the properties are fetched
+        QTRY_COMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
     }
 
     void test_invalid_property_data()
@@ -147,8 +209,8 @@ private Q_SLOTS:
         QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("InvalidPropertyWatcher.qml"));
         UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
         QVERIFY(watcher);
-        // error should contain the warning
-        QCOMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
+        // error should contain the warning once the properties are fetched
+        QTRY_COMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
     }
 
     void test_one_valid_one_invalid_property_data()
@@ -171,8 +233,8 @@ private Q_SLOTS:
         QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("InvalidPropertyWatcher2.qml"));
         UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
         QVERIFY(watcher);
-        // error should contain the wearning
-        QCOMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
+        // error should contain the wearning once the properties are fetched
+        QTRY_COMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
     }
 
     void test_change_connection_props_data()
@@ -211,6 +273,64 @@ private Q_SLOTS:
         QCOMPARE(watcher->property("error").toString(), QString("Changing connection parameters forbidden."));
     }
 
+    void test_session_bus_service()
+    {
+        if (!sessionError.isEmpty()) {
+            QSKIP(qPrintable(sessionError));
+        }
+        QQmlEngine engine;
+        QScopedPointer<UCServiceProperties> watcher(createSessionWatcher(&engine, "SessionServiceWatcher.qml"));
+        QVERIFY(watcher);
+        // the component completes without waiting for the service
+        QCOMPARE(watcher->status(), UCServiceProperties::Synchronizing);
+        QCOMPARE(watcher->property("incomingCallVibrate").toBool(), true);
+
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+        QCOMPARE(watcher->property("incomingCallVibrate").toBool(), false);
+        QCOMPARE(watcher->property("ringtoneName").toString(), QString("Marimba"));
+        QCOMPARE(watcher->property("error").toString(), QString());
+    }
+
+    void test_session_bus_service_invalid_property()
+    {
+        if (!sessionError.isEmpty()) {
+            QSKIP(qPrintable(sessionError));
+        }
+        QQmlEngine engine;
+        QScopedPointer<UCServiceProperties> watcher(
+            createSessionWatcher(&engine, "SessionInvalidPropertyWatcher.qml"));
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+        QCOMPARE(watcher->property("error").toString(), QString("No such property 'ThisIsAnInvalidPropertyToWatch'"));
+    }
+
+    // Time spent in the GUI thread until the component is completed.
+    void benchmark_session_bus_startup()
+    {
+        if (!sessionError.isEmpty()) {
+            QSKIP(qPrintable(sessionError));
+        }
+        QQmlEngine engine;
+        QBENCHMARK {
+            QScopedPointer<UCServiceProperties> watcher(createSessionWatcher(&engine, "SessionServiceWatcher.qml"));
+            QCOMPARE(watcher->status(), UCServiceProperties::Synchronizing);
+        }
+    }
+
+    // Time spent until the property values are synchronized with the service.
+    void benchmark_session_bus_synchronization()
+    {
+        if (!sessionError.isEmpty()) {
+            QSKIP(qPrintable(sessionError));
+        }
+        QQmlEngine engine;
+        QBENCHMARK {
+            QScopedPointer<UCServiceProperties> watcher(createSessionWatcher(&engine, "SessionServiceWatcher.qml"));
+            QSignalSpy spy(watcher.data(), SIGNAL(statusChanged()));
+            QVERIFY(spy.wait());
+            QCOMPARE(watcher->status(), UCServiceProperties::Active);
+        }
+    }
 };
 
 QTEST_MAIN(tst_ServiceProperties)
@@ -805,6 +805,40 @@ private Q_SLOTS:
         QCOMPARE(QuickUtils::className(styleItem), QString("ButtonStyle"));
     }
 
+    void test_asynchronous_style()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("AsynchronousStyle.qml"));
+        // create a second instance without returning to the event loop, so that the
+        // style incubation cannot complete before it is checked
+        QQmlComponent component(view->engine(), QUrl::fromLocalFile("AsynchronousStyle.qml"));
+        QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem*>(component.beginCreate(view->rootContext())));
+        QVERIFY(root);
+        root->setParentItem(view->rootObject());
+        component.completeCreate();
+        UCStyledItemBase *button = root->findChild<UCStyledItemBase*>("TestButton");
+        QVERIFY(button);
+        UCStyledItemBasePrivate *d = UCStyledItemBasePrivate::get(button);
+        QVERIFY(d->asynchronousStyle());
+
+        QVERIFY(!d->styleInstance());
+        QTRY_VERIFY(d->styleInstance());
+        QCOMPARE(QuickUtils::className(d->styleInstance()), QString("ButtonStyle"));
+        QCOMPARE(d->styleInstance()->parentItem(), button);
+    }
+
+    void test_asynchronous_style_reloaded_when_theme_changes()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("AsynchronousStyle.qml"));
+        UCStyledItemBase *button = view->findItem<UCStyledItemBase*>("TestButton");
+        UCStyledItemBasePrivate *d = UCStyledItemBasePrivate::get(button);
+        QTRY_VERIFY(d->styleInstance());
+
+        QSignalSpy spy(button, SIGNAL(styleInstanceChanged()));
+        button->getTheme()->setName("Ubuntu.Components.Themes.SuruDark");
+        QTRY_VERIFY(d->styleInstance());
+        QCOMPARE(spy.count(), 1);
+    }
+
     void test_stylename_extension_failure()
     {
         ThemeTestCase::ignoreWarning("DeprecatedTheme.qml", 19, 1, "QML StyledItem: Warning: Style OptionSelectorStyle.qml.qml not found in theme Ubuntu.Components.Themes.SuruGradient");
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+Item {
+    width: 400
+    height: 400
+
+    property alias count: repeater.model
+
+    Grid {
+        anchors.fill: parent
+        columns: 50
+        Repeater {
+            id: repeater
+            model: 0
+            UbuntuShape {
+                width: 8
+                height: 8
+                aspect: index % 3
+                radius: index % 2 ? "small" : "medium"
+                backgroundColor: Qt.rgba((index % 10) / 10, 0.5, 0.5, 1.0)
+            }
+        }
+    }
+}
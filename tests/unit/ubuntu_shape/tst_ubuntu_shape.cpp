@@ -17,8 +17,12 @@
  */
 
 #include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickItem>
 #include <QtQuick/QQuickView>
 #include <QtTest/QtTest>
+#include <UbuntuToolkit/private/ucubuntushape_p.h>
+
+UT_USE_NAMESPACE
 
 class tst_UbuntuShape: public QObject
 {
@@ -27,6 +31,22 @@ class tst_UbuntuShape: public QObject
 private:
     QQuickView *m_quickView;
 
+    void addImportPath(QQmlEngine *engine)
+    {
+        // add modules folder so we have access to the plugin from QML
+        QString modules(UBUNTU_QML_IMPORT_PATH);
+        QStringList imports = engine->importPathList();
+        imports.prepend(QDir(modules).absolutePath());
+        engine->setImportPathList(imports);
+    }
+
+    bool renderFrame(QQuickView *view)
+    {
+        QSignalSpy spy(view, SIGNAL(frameSwapped()));
+        view->update();
+        return spy.wait();
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -34,13 +54,7 @@ private Q_SLOTS:
         m_quickView = new QQuickView;
         m_quickView->setGeometry(0, 0, 900, 500);
         m_quickView->show();
-
-        // add modules folder so we have access to the plugin from QML
-        QQmlEngine *engine = m_quickView->engine();
-        QString modules(UBUNTU_QML_IMPORT_PATH);
-        QStringList imports = engine->importPathList();
-        imports.prepend(QDir(modules).absolutePath());
-        engine->setImportPathList(imports);
+        addImportPath(m_quickView->engine());
     }
 
     void noDistortion() {
@@ -56,6 +70,72 @@ private Q_SLOTS:
 
         QCOMPARE(result, expected);
     }
+
+    void mipmapTexturesFromDistanceFields()
+    {
+        // The flat and inset aspects texture stores the shape masks in the B and A channels, the
+        // drop shadow aspect one in the R and G channels. The textures contain the top-left
+        // corner of the shape, so the first texel is outside and the last one is inside.
+        const int maskChannel[shapeTextureCount] = { 2, 0 };
+        const int lastTexel = (shapeTextureMipmapWidth * shapeTextureMipmapHeight - 1) * 4;
+        QScopedArrayPointer<quint8> data(new quint8[shapeTextureMipmapSize]);
+        for (int i = 0; i < shapeTextureCount; i++) {
+            createShapeTextureMipmaps(i, data.data());
+            QCOMPARE(data[maskChannel[i]], static_cast<quint8>(0));
+            QCOMPARE(data[maskChannel[i] + 1], static_cast<quint8>(0));
+            QCOMPARE(data[lastTexel + maskChannel[i]], static_cast<quint8>(255));
+            QCOMPARE(data[lastTexel + maskChannel[i] + 1], static_cast<quint8>(255));
+        }
+    }
+
+    void benchmarkMipmapTextures()
+    {
+        QScopedArrayPointer<quint8> data(new quint8[shapeTextureMipmapSize]);
+        QBENCHMARK {
+            for (int i = 0; i < shapeTextureCount; i++) {
+                createShapeTextureMipmaps(i, data.data());
+            }
+        }
+    }
+
+    // Shape textures are shared by all the shapes of a graphics context, make sure they are
+    // correctly set up and released while shapes are created and destroyed in several windows.
+    void createAndDestroyShapesInSeveralWindows()
+    {
+        const int windowCount = 3;
+        const int shapeCount = 2000;
+        QList<QQuickView*> views;
+        for (int i = 0; i < windowCount; i++) {
+            QQuickView *view = new QQuickView;
+            view->setGeometry(i * 50, i * 50, 400, 400);
+            addImportPath(view->engine());
+            view->setSource(QUrl::fromLocalFile("ManyShapes.qml"));
+            QVERIFY(view->rootObject());
+            view->show();
+            QVERIFY(QTest::qWaitForWindowExposed(view));
+            views.append(view);
+        }
+
+        for (int i = 0; i < 10; i++) {
+            Q_FOREACH(QQuickView *view, views) {
+                view->rootObject()->setProperty("count", (i % 2) ? 0 : shapeCount);
+            }
+            Q_FOREACH(QQuickView *view, views) {
+                QVERIFY(renderFrame(view));
+            }
+        }
+
+        // Close the windows one after the other while the remaining ones keep rendering shapes.
+        while (!views.isEmpty()) {
+            delete views.takeFirst();
+            Q_FOREACH(QQuickView *view, views) {
+                view->rootObject()->setProperty("count", shapeCount);
+                QVERIFY(renderFrame(view));
+                view->rootObject()->setProperty("count", 0);
+                QVERIFY(renderFrame(view));
+            }
+        }
+    }
 };
 
 QTEST_MAIN(tst_UbuntuShape)
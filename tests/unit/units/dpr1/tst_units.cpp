@@ -282,6 +282,41 @@ private Q_SLOTS:
         expected = QString("0.875/" + QDir::currentPath() + QDir::separator() + "resource@8.png");
         QCOMPARE(resolved, expected);
     }
+
+    void resolveFollowsDirectoryChanges() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        UCUnits units;
+        units.setGridUnit(10);
+        const QUrl url = QUrl::fromLocalFile(dir.path() + "/asset.png");
+        QCOMPARE(units.resolveResource(url), QString());
+
+        QVERIFY(QFile::copy("resource@15.png", dir.path() + "/asset@15.png"));
+        QTRY_COMPARE(units.resolveResource(url), QString("0.666667/" + dir.path() + "/asset@15.png"));
+
+        QVERIFY(QFile::copy("resource@10.png", dir.path() + "/asset@10.png"));
+        QTRY_COMPARE(units.resolveResource(url), QString("1/" + dir.path() + "/asset@10.png"));
+    }
+
+    void benchmarkResolveResource_data() {
+        QTest::addColumn<QUrl>("url");
+
+        QTest::newRow("exact match") << QUrl::fromLocalFile("exact_match.png");
+        QTest::newRow("multiple grid units") << QUrl::fromLocalFile("resource.png");
+        QTest::newRow("qrc, only smaller grid unit") << QUrl("qrc:/test/prefix/resource_only_smaller.png");
+        QTest::newRow("non existing") << QUrl::fromLocalFile("non_existing.png");
+    }
+
+    void benchmarkResolveResource() {
+        QFETCH(QUrl, url);
+        UCUnits units;
+        units.setGridUnit(9);
+        // the first resolution indexes the directory
+        units.resolveResource(url);
+        QBENCHMARK {
+            units.resolveResource(url);
+        }
+    }
 };
 
 QTEST_MAIN(tst_UCUnits)
@@ -878,6 +878,33 @@ Item {
             selectedIndicesSpy.wait();
         }
 
+        function test_select_range_and_all() {
+            listView.ViewItems.selectedIndices = [];
+            selectedIndicesSpy.clear();
+            listView.ViewItems.selectRange(3, 1);
+            compare(selectedIndicesSpy.count, 1, "Range selection should be notified once");
+            compare(listView.ViewItems.selectedIndices, [1, 2, 3]);
+            // ranges are clamped to the view
+            listView.ViewItems.selectRange(-5, 1);
+            compare(listView.ViewItems.selectedIndices, [0, 1, 2, 3]);
+            // already selected range does not notify
+            selectedIndicesSpy.clear();
+            listView.ViewItems.selectRange(1, 2);
+            compare(selectedIndicesSpy.count, 0, "Nothing should change");
+            listView.ViewItems.selectAll();
+            compare(selectedIndicesSpy.count, 1, "Select all should be notified once");
+            compare(listView.ViewItems.selectedIndices.length, listView.count);
+            listView.ViewItems.selectedIndices = [];
+        }
+
+        function test_select_range_clamped_to_children() {
+            testColumn.ViewItems.selectedIndices = [];
+            testColumn.ViewItems.selectRange(0, 1000000000);
+            compare(testColumn.ViewItems.selectedIndices.length, testColumn.children.length);
+            compare(testColumn.ViewItems.selectedIndices[testColumn.children.length - 1], testColumn.children.length - 1);
+            testColumn.ViewItems.selectedIndices = [];
+        }
+
         function test_no_tug_when_selectable() {
             movingSpy.target = testItem;
             toggleSelectMode(testColumn, true);
@@ -77,11 +77,16 @@ int main(int argc, const char *argv[])
     QCommandLineOption _metricsOverlay("metrics-overlay", "Enable the metrics overlay");
     QCommandLineOption _metricsLogging(
         "metrics-logging", "Enable metrics logging, <device> can be 'stdout', 'lttng' (Linux "
-        "only), a local or absolute filename", "device");
+        "only), a local or absolute filename, a filename prefixed by 'binary:' to log in the "
+        "binary format or 'flightrecorder[:<seconds>]' to keep the last seconds in a memory "
+        "mapped file", "device");
     QCommandLineOption _metricsLoggingFilter(
         "metrics-logging-filter", "Filter metrics logging, <filter> is a list of events separated "
-        "by a comma ('window', 'process', 'frame' or '*'), events not filtered are discarded",
-        "filter");
+        "by a comma ('window', 'process', 'frame', 'framesummary' or '*'), events not filtered "
+        "are discarded", "filter");
+    QCommandLineOption _metricsFrameSummary(
+        "metrics-frame-summary", "Log a summary of the frame times every <interval> milliseconds",
+        "interval");
 
     args.addOption(_import);
     args.addOption(_enableTouch);
@@ -92,6 +97,7 @@ int main(int argc, const char *argv[])
     args.addOption(_metricsOverlay);
     args.addOption(_metricsLogging);
     args.addOption(_metricsLoggingFilter);
+    args.addOption(_metricsFrameSummary);
     args.addPositionalArgument("filename", "Document to be viewed");
     args.setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
     args.addHelpOption();
@@ -230,10 +236,16 @@ int main(int argc, const char *argv[])
                 filter |= UMApplicationMonitor::FrameEvent;
             } else if (filterList[i] == "generic") {
                 filter |= UMApplicationMonitor::GenericEvent;
+            } else if (filterList[i] == "framesummary") {
+                filter |= UMApplicationMonitor::FrameSummaryEvent;
             }
         }
         applicationMonitor->setLoggingFilter(filter);
     }
+    if (args.isSet(_metricsFrameSummary)) {
+        applicationMonitor->setUpdateInterval(
+            UMEvent::FrameSummary, args.value(_metricsFrameSummary).toInt());
+    }
     if (args.isSet(_metricsLogging)) {
         UMLogger* logger;
         QString device = args.value(_metricsLogging);
@@ -243,6 +255,12 @@ int main(int argc, const char *argv[])
         } else if (device == "lttng") {
             logger = new UMLTTNGLogger();
 #endif  // defined(Q_OS_LINUX)
+        } else if (device.startsWith("binary:")) {
+            logger = new UMBinaryFileLogger(device.mid(sizeof("binary:") - 1));
+        } else if (device == "flightrecorder" || device.startsWith("flightrecorder:")) {
+            const int duration = device.mid(sizeof("flightrecorder:") - 1).toInt();
+            logger = duration > 0
+                ? new UMFlightRecorderLogger(duration) : new UMFlightRecorderLogger();
         } else {
             logger = new UMFileLogger(device);
         }